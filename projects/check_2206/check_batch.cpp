@@ -0,0 +1,196 @@
+#include "check_batch.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <system_error>
+
+namespace check {
+
+namespace {
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// 去除首尾空白字符（与交互输入的处理相同）
+std::string_view trim(std::string_view line) {
+    while (!line.empty() && isBlank(line.front())) line.remove_prefix(1);
+    while (!line.empty() && isBlank(line.back())) line.remove_suffix(1);
+    return line;
+}
+
+// 一次读入整个文件
+std::optional<std::string> readFile(const std::string& filename) {
+    // 目录也能用 ifstream 打开，但 tellg() 得不到有意义的大小
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(filename, error)) {
+        return std::nullopt;
+    }
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return std::nullopt;
+    }
+    const std::streamoff size = file.tellg();
+    if (size < 0) {
+        return std::nullopt;
+    }
+    std::string data(static_cast<size_t>(size), '\0');
+    file.seekg(0);
+    if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+        return std::nullopt;
+    }
+    return data;
+}
+
+} // namespace
+
+std::string errorMessage(AmountError error) {
+    switch (error) {
+    case AmountError::None:
+        return "";
+    case AmountError::Empty:
+        return "输入不能为空";
+    case AmountError::InvalidChar:
+        return "非法字符。只允许数字、逗号和小数点。";
+    case AmountError::MultipleDots:
+        return "发现多个小数点";
+    case AmountError::CommaInDecimal:
+        return "小数部分不允许使用逗号";
+    case AmountError::IntegerTooLong:
+        return "整数部分超过最大" + std::to_string(MAX_INTEGER_DIGITS) + "位数字";
+    case AmountError::DecimalTooLong:
+        return "小数部分超过最大" + std::to_string(MAX_DECIMAL_DIGITS) + "位数字";
+    case AmountError::TooWide:
+        return "金额总长度超过" + std::to_string(MAX_DISPLAY_WIDTH) + "个字符";
+    }
+    return "";
+}
+
+AmountError formatProtected(std::string_view input, char* field) noexcept {
+    if (input.empty()) {
+        return AmountError::Empty;
+    }
+
+    // 一遍扫描：检查字符，记下小数点的位置和个数
+    size_t dot = std::string_view::npos;
+    size_t dots = 0;
+    bool invalid = false;
+    for (size_t i = 0; i < input.size(); ++i) {
+        const char c = input[i];
+        if (c == '.') {
+            if (dots++ == 0) dot = i;
+        } else if (!isDigit(c) && c != ',') {
+            invalid = true;
+        }
+    }
+    if (invalid) {
+        return AmountError::InvalidChar;
+    }
+    if (dots > 1) {
+        return AmountError::MultipleDots;
+    }
+
+    std::string_view integer = input.substr(0, dot);
+    const std::string_view decimal = dot == std::string_view::npos ? std::string_view{}
+                                                                   : input.substr(dot + 1);
+    if (decimal.find(',') != std::string_view::npos) {
+        return AmountError::CommaInDecimal;
+    }
+
+    // 跳过前导零和其中的逗号，剩下的数字为有效整数位；全为零时保留一个 0
+    const size_t first = integer.find_first_not_of("0,");
+    integer.remove_prefix(first == std::string_view::npos ? integer.size() : first);
+    const auto digits = static_cast<size_t>(std::count_if(integer.begin(), integer.end(), isDigit));
+    const size_t integer_length = std::max<size_t>(digits, 1);
+
+    if (integer_length > MAX_INTEGER_DIGITS) {
+        return AmountError::IntegerTooLong;
+    }
+    if (decimal.size() > MAX_DECIMAL_DIGITS) {
+        return AmountError::DecimalTooLong;
+    }
+    const size_t content_length = integer_length + (decimal.empty() ? 0 : 1 + decimal.size());
+    if (content_length > MAX_DISPLAY_WIDTH) {
+        return AmountError::TooWide;
+    }
+
+    // 从右向左写：小数部分、小数点、整数部分，剩下的填充星号
+    char* p = field + MAX_DISPLAY_WIDTH;
+    if (!decimal.empty()) {
+        p -= decimal.size();
+        std::memcpy(p, decimal.data(), decimal.size());
+        *--p = '.';
+    }
+    if (digits == 0) {
+        *--p = '0';
+    }
+    for (auto it = integer.rbegin(); it != integer.rend(); ++it) {
+        if (*it != ',') *--p = *it;
+    }
+    std::memset(field, FILL_CHAR, static_cast<size_t>(p - field));
+    return AmountError::None;
+}
+
+BatchResult formatBatch(std::string_view text, size_t max_lines, char* out,
+                        std::vector<BatchError>& errors, size_t first_line) {
+    BatchResult result{0, 0, 0};
+    char* record = out;
+
+    while (result.lines < max_lines && result.consumed < text.size()) {
+        // 取出一行（最后一行可以没有换行符）
+        const char* begin = text.data() + result.consumed;
+        const size_t rest = text.size() - result.consumed;
+        const auto* newline = static_cast<const char*>(std::memchr(begin, '\n', rest));
+        const size_t length = newline != nullptr ? static_cast<size_t>(newline - begin) : rest;
+        result.consumed += newline != nullptr ? length + 1 : length;
+
+        const AmountError error = formatProtected(trim({begin, length}), record);
+        if (error != AmountError::None) {
+            // 写入占位记录，保持输出与输入逐行对应
+            std::memset(record, REJECTED_FILL, MAX_DISPLAY_WIDTH);
+            errors.push_back({first_line + result.lines, error});
+        }
+        record[MAX_DISPLAY_WIDTH] = '\n';
+        record += RECORD_WIDTH;
+        ++result.lines;
+    }
+
+    result.written = static_cast<size_t>(record - out);
+    return result;
+}
+
+std::optional<BatchStats> processFile(const std::string& filename, std::ostream& out,
+                                      size_t batch_lines) {
+    const auto text = readFile(filename);
+    if (!text) {
+        return std::nullopt;
+    }
+
+    batch_lines = std::max<size_t>(batch_lines, 1);
+    const auto buffer = std::make_unique<char[]>(batch_lines * RECORD_WIDTH);
+    BatchStats stats;
+
+    for (std::string_view rest = *text; !rest.empty();) {
+        const BatchResult batch = formatBatch(rest, batch_lines, buffer.get(), stats.errors, stats.lines + 1);
+        if (!out.write(buffer.get(), static_cast<std::streamsize>(batch.written))) {
+            return std::nullopt;
+        }
+        stats.lines += batch.lines;
+        rest.remove_prefix(batch.consumed);
+    }
+
+    if (!out.flush()) {
+        return std::nullopt;
+    }
+    stats.formatted = stats.lines - stats.errors.size();
+    return stats;
+}
+
+} // namespace check
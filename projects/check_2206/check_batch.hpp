@@ -0,0 +1,89 @@
+#ifndef CHECK_BATCH_HPP
+#define CHECK_BATCH_HPP
+
+#include "check_protection.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace check {
+
+// 每条输出记录的宽度：保护格式加换行
+constexpr size_t RECORD_WIDTH = MAX_DISPLAY_WIDTH + 1;
+
+// 每批处理的行数
+constexpr size_t DEFAULT_BATCH_LINES = 1 << 16;
+
+/**
+ * AmountError - 金额解析错误
+ *
+ * 与 CheckAmount 抛出 InvalidAmountError 的各种情况一一对应，
+ * 多个错误同时存在时按 CheckAmount 的检查顺序取第一个
+ */
+enum class AmountError : std::uint8_t {
+    None,
+    Empty,           // 输入为空
+    InvalidChar,     // 含有数字、逗号、小数点以外的字符
+    MultipleDots,    // 多个小数点
+    CommaInDecimal,  // 小数部分含有逗号
+    IntegerTooLong,  // 整数部分超过 MAX_INTEGER_DIGITS 位
+    DecimalTooLong,  // 小数部分超过 MAX_DECIMAL_DIGITS 位
+    TooWide          // 总长度超过 MAX_DISPLAY_WIDTH
+};
+
+// 错误的说明文字
+[[nodiscard]] std::string errorMessage(AmountError error);
+
+// 解析金额并把保护格式写入 field（MAX_DISPLAY_WIDTH 字节，不含 '\0'），
+// 结果与 CheckAmount(input).getProtectedFormat() 相同，但不分配内存、不抛出异常；
+// 出错时 field 的内容不确定
+[[nodiscard]] AmountError formatProtected(std::string_view input, char* field) noexcept;
+
+// 一行解析失败的记录
+struct BatchError {
+    size_t line;  // 行号，从 1 开始
+    AmountError error;
+};
+
+// 无效的行输出的占位记录内容：整个字段都是填充字符（有效金额至少含一个数字，不会与之混淆）
+constexpr char REJECTED_FILL = FILL_CHAR;
+
+// 一批的处理结果
+struct BatchResult {
+    size_t consumed;  // 处理过的输入字节数（到最后一行的换行符之后）
+    size_t lines;     // 处理的行数，也是写入的记录数
+    size_t written;   // 写入的字节数
+};
+
+/**
+ * formatBatch - 批量格式化
+ *
+ * 从 text 开头逐行处理最多 max_lines 行（每行一个金额，首尾空白被忽略），
+ * 每行向 out 写入一条 RECORD_WIDTH 字节的定长记录，
+ * out 至少要有 max_lines * RECORD_WIDTH 字节；
+ * 无效的行（包括空行）写入全为 REJECTED_FILL 的占位记录并追加到 errors，
+ * 行号从 first_line 开始计，输出的第 i 条记录总是对应输入的第 i 行
+ */
+BatchResult formatBatch(std::string_view text, size_t max_lines, char* out,
+                        std::vector<BatchError>& errors, size_t first_line = 1);
+
+// 整个文件的处理统计
+struct BatchStats {
+    size_t lines = 0;
+    size_t formatted = 0;
+    std::vector<BatchError> errors;
+};
+
+// 读入金额文件，每 batch_lines 行格式化一批，每批用一次 write 写到 out，
+// 输出与输入逐行对应；
+// 文件无法读取或写入失败时返回 nullopt
+[[nodiscard]] std::optional<BatchStats> processFile(const std::string& filename, std::ostream& out,
+                                                    size_t batch_lines = DEFAULT_BATCH_LINES);
+
+} // namespace check
+
+#endif // CHECK_BATCH_HPP
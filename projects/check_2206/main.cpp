@@ -1,4 +1,6 @@
+#include "check_batch.hpp"
 #include "check_protection.hpp"
+#include <fstream>
 #include <iostream>
 #include <iomanip>
 #include <string>
@@ -56,7 +58,41 @@ void runDemo() {
     std::cout << "\n";
 }
 
-int main() {
+// 批量模式：每行一个金额，保护格式逐行写到输出，无效的行输出占位记录并报告到标准错误
+int runBatch(const std::string& input, const char* output) {
+    std::ofstream file;
+    if (output != nullptr) {
+        file.open(output, std::ios::binary);
+        if (!file) {
+            std::cerr << "无法打开输出文件: " << output << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = output != nullptr ? file : std::cout;
+
+    const auto stats = check::processFile(input, out);
+    if (!stats) {
+        std::cerr << "无法读取 " << input << " 或写入失败\n";
+        return 1;
+    }
+
+    for (const auto& error : stats->errors) {
+        std::cerr << "第 " << error.line << " 行: " << check::errorMessage(error.error) << "\n";
+    }
+    std::cerr << "共 " << stats->lines << " 行，格式化 " << stats->formatted << " 个，无效 "
+              << stats->errors.size() << " 个\n";
+    return stats->errors.empty() ? 0 : 2;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        if (std::string(argv[1]) != "--batch" || argc < 3 || argc > 4) {
+            std::cerr << "用法: " << argv[0] << " [--batch 输入文件 [输出文件]]\n";
+            return 1;
+        }
+        return runBatch(argv[2], argc > 3 ? argv[3] : nullptr);
+    }
+
     printUsage();
 
     // 运行演示
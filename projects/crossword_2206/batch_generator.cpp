@@ -0,0 +1,70 @@
+/**
+ * batch_generator.cpp
+ * 填字谜生成器 - BatchGenerator 类实现
+ */
+
+#include "batch_generator.h"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
+
+BatchGenerator::BatchGenerator(const std::vector<std::string>& words, const int size,
+                               const int maxWords)
+    : words_(words), size_(size), maxWords_(maxWords) {
+}
+
+std::vector<BatchGenerator::Result> BatchGenerator::run(const int attempts, const int keep,
+                                                        unsigned threads,
+                                                        const unsigned baseSeed) const {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // 线程数多于尝试次数时，多出来的线程领不到任务
+    threads = std::min(threads, static_cast<unsigned>(std::max(attempts, 1)));
+    const size_t limit = static_cast<size_t>(std::max(keep, 0));
+
+    // 每个线程保留自己的前 keep 个结果，最后再合并
+    std::vector<std::vector<Result>> partial(threads);
+    std::atomic<int> next{0};
+
+    auto worker = [&](const unsigned id) {
+        std::vector<Result>& best = partial[id];
+        for (int i = next.fetch_add(1); i < attempts; i = next.fetch_add(1)) {
+            const unsigned seed = baseSeed + static_cast<unsigned>(i);
+            std::vector<std::string> words = words_;
+            Board board(size_, maxWords_);
+            board.placeWords(words, seed);
+
+            Result result{seed, std::move(board), {}};
+            result.quality = result.board.evaluate();
+
+            // 插入有序的前 keep 个
+            if (best.size() == limit && (limit == 0 || !better(result, best.back()))) continue;
+            best.insert(std::ranges::upper_bound(best, result, better), std::move(result));
+            if (best.size() > limit) best.pop_back();
+        }
+    };
+
+    std::vector<std::jthread> pool;
+    for (unsigned id = 1; id < threads; ++id) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    pool.clear();
+
+    std::vector<Result> results;
+    for (auto& part : partial) {
+        std::ranges::move(part, std::back_inserter(results));
+    }
+    std::ranges::sort(results, better);
+    if (results.size() > limit) {
+        results.erase(results.begin() + static_cast<std::ptrdiff_t>(limit), results.end());
+    }
+    return results;
+}
+
+bool BatchGenerator::better(const Result& a, const Result& b) {
+    if (a.quality.score != b.quality.score) return a.quality.score > b.quality.score;
+    return a.seed < b.seed;
+}
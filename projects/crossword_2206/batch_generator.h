@@ -0,0 +1,41 @@
+/**
+ * batch_generator.h
+ * 填字谜生成器 - BatchGenerator 类声明
+ *
+ * 功能：用同一组单词并行生成多个不同的填字谜，按质量保留最好的几个
+ */
+
+#pragma once
+
+#include "board.h"
+#include <string>
+#include <vector>
+
+class BatchGenerator {
+public:
+    // 一次生成的结果
+    struct Result {
+        unsigned seed;
+        Board board;
+        Board::Quality quality;
+    };
+
+    // words 在生成过程中只读，每次尝试复制一份交给自己的棋盘
+    BatchGenerator(const std::vector<std::string>& words, int size, int maxWords);
+
+    // 命令行接受的最大线程数
+    static constexpr int MAX_THREADS = 1024;
+
+    // 用种子 baseSeed, baseSeed + 1, ... 生成 attempts 个填字谜，返回得分最高的 keep 个
+    // threads 为 0 时使用全部硬件线程，不超过 attempts；结果与线程数无关
+    [[nodiscard]] std::vector<Result> run(int attempts, int keep, unsigned threads = 0,
+                                          unsigned baseSeed = 1) const;
+
+private:
+    const std::vector<std::string>& words_;
+    int size_;
+    int maxWords_;
+
+    // 结果排序：得分高的在前，同分时种子小的在前
+    static bool better(const Result& a, const Result& b);
+};
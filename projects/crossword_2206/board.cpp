@@ -9,24 +9,37 @@
 #include <random>
 #include <iomanip>
 
-Board::Board() : grid_{} {
+Board::Board(const int size, const int maxWords)
+    : size_(size), maxWords_(maxWords), grid_(static_cast<size_t>(size) * size, '.') {
     // 初始化棋盘为空白
-    for (auto& row : grid_) {
-        row.fill('.');
-    }
 }
 
 char Board::getSpot(const int row, const int col) const {
-    if (row >= 0 && row < SIZE && col >= 0 && col < SIZE) {
-        return grid_[row][col];
+    if (row >= 0 && row < size_ && col >= 0 && col < size_) {
+        return at(row, col);
     }
     return '\0';
 }
 
 void Board::setSpot(const int row, const int col, const char c) {
-    if (row >= 0 && row < SIZE && col >= 0 && col < SIZE) {
-        grid_[row][col] = c;
+    if (row >= 0 && row < size_ && col >= 0 && col < size_) {
+        writeCell(row, col, c);
+    }
+}
+
+void Board::writeCell(const int row, const int col, const char c) {
+    char& cell = at(row, col);
+    if (cell == c) return;
+
+    const int index = row * size_ + col;
+    if (cell >= 'A' && cell <= 'Z') {
+        auto& cells = letterCells_[cell - 'A'];
+        cells.erase(std::ranges::find(cells, index));
+    }
+    if (c >= 'A' && c <= 'Z') {
+        letterCells_[c - 'A'].push_back(index);
     }
+    cell = c;
 }
 
 void Board::placeWords(std::vector<std::string>& words) {
@@ -43,16 +56,39 @@ void Board::placeWords(std::vector<std::string>& words) {
         std::ranges::transform(word.begin(), word.end(), word.begin(), toupper);
     }
 
+    placeSorted(words, nullptr);
+}
+
+void Board::placeWords(std::vector<std::string>& words, const unsigned seed) {
+    if (words.empty()) return;
+
+    std::mt19937 rng(seed);
+
+    // 先随机打乱，再按长度降序稳定排序：同长度单词的顺序由 seed 决定
+    std::ranges::shuffle(words, rng);
+    std::ranges::stable_sort(words, [](const std::string& a, const std::string& b) {
+        return a.length() > b.length();
+    });
+
+    // 转换为大写
+    for (auto& word : words) {
+        std::ranges::transform(word.begin(), word.end(), word.begin(), toupper);
+    }
+
+    placeSorted(words, &rng);
+}
+
+void Board::placeSorted(const std::vector<std::string>& words, std::mt19937* rng) {
     // 放置第一个单词（最长的）在中央水平位置
     const std::string& firstWord = words[0];
-    constexpr int startRow = SIZE / 2;
-    const int startCol = (SIZE - static_cast<int>(firstWord.length())) / 2;
+    const int startRow = size_ / 2;
+    const int startCol = (size_ - static_cast<int>(firstWord.length())) / 2;
     placeWord(firstWord, startRow, startCol, Direction::Horizontal);
 
     // 交替尝试垂直和水平放置剩余单词
     bool tryVerticalFirst = true;
 
-    for (size_t i = 1; i < words.size() && placedCount_ < MAX_WORDS; ++i) {
+    for (size_t i = 1; i < words.size() && placedCount_ < maxWords_; ++i) {
         const std::string& word = words[i];
         int bestRow = -1, bestCol = -1;
         int bestScore = 0;
@@ -60,14 +96,14 @@ void Board::placeWords(std::vector<std::string>& words) {
 
         if (tryVerticalFirst) {
             // 先尝试垂直
-            int score = tryPlaceVertical(word, bestRow, bestCol);
+            int score = tryPlaceVertical(word, bestRow, bestCol, rng);
             if (score > 0) {
                 bestScore = score;
                 bestDir = Direction::Vertical;
             }
             // 再尝试水平
             int hRow, hCol;
-            score = tryPlaceHorizontal(word, hRow, hCol);
+            score = tryPlaceHorizontal(word, hRow, hCol, rng);
             if (score > bestScore) {
                 bestScore = score;
                 bestRow = hRow;
@@ -76,14 +112,14 @@ void Board::placeWords(std::vector<std::string>& words) {
             }
         } else {
             // 先尝试水平
-            int score = tryPlaceHorizontal(word, bestRow, bestCol);
+            int score = tryPlaceHorizontal(word, bestRow, bestCol, rng);
             if (score > 0) {
                 bestScore = score;
                 bestDir = Direction::Horizontal;
             }
             // 再尝试垂直
             int vRow, vCol;
-            score = tryPlaceVertical(word, vRow, vCol);
+            score = tryPlaceVertical(word, vRow, vCol, rng);
             if (score > bestScore) {
                 bestScore = score;
                 bestRow = vRow;
@@ -100,33 +136,59 @@ void Board::placeWords(std::vector<std::string>& words) {
     }
 }
 
-int Board::tryPlaceHorizontal(const std::string& word, int& bestRow, int& bestCol) const {
-    int bestScore = 0;
-    const int wordLen = static_cast<int>(word.length());
-
-    for (int row = 0; row < SIZE; ++row) {
-        for (int col = 0; col <= SIZE - wordLen; ++col) {
-            if (const int score = evaluatePosition(word, row, col, Direction::Horizontal); score > bestScore) {
-                bestScore = score;
-                bestRow = row;
-                bestCol = col;
-            }
-        }
-    }
+int Board::tryPlaceHorizontal(const std::string& word, int& bestRow, int& bestCol,
+                              std::mt19937* rng) const {
+    return tryPlaceAtIntersections(word, Direction::Horizontal, bestRow, bestCol, rng);
+}
 
-    return bestScore;
+int Board::tryPlaceVertical(const std::string& word, int& bestRow, int& bestCol,
+                            std::mt19937* rng) const {
+    return tryPlaceAtIntersections(word, Direction::Vertical, bestRow, bestCol, rng);
 }
 
-int Board::tryPlaceVertical(const std::string& word, int& bestRow, int& bestCol) const {
+int Board::tryPlaceAtIntersections(const std::string& word, const Direction dir,
+                                   int& bestRow, int& bestCol, std::mt19937* rng) const {
     int bestScore = 0;
+    int ties = 0;
     const int wordLen = static_cast<int>(word.length());
 
-    for (int row = 0; row <= SIZE - wordLen; ++row) {
-        for (int col = 0; col < SIZE; ++col) {
-            if (const int score = evaluatePosition(word, row, col, Direction::Vertical); score > bestScore) {
+    // 已有单词之后的位置必须至少有一个交叉点，所以只需检查
+    // “单词的第 i 个字母落在棋盘上相同字母处”的起点
+    for (int i = 0; i < wordLen; ++i) {
+        if (word[i] < 'A' || word[i] > 'Z') continue;
+
+        for (const int cell : letterCells_[word[i] - 'A']) {
+            int row = cell / size_;
+            int col = cell % size_;
+            if (dir == Direction::Horizontal) {
+                col -= i;
+                if (col < 0 || col + wordLen > size_) continue;
+            } else {
+                row -= i;
+                if (row < 0 || row + wordLen > size_) continue;
+            }
+
+            const int score = evaluatePosition(word, row, col, dir);
+            if (score == 0) continue;
+
+            if (score > bestScore) {
                 bestScore = score;
                 bestRow = row;
                 bestCol = col;
+                ties = 1;
+            } else if (score == bestScore) {
+                if (rng != nullptr) {
+                    // 蓄水池抽样：第 k 个同分位置以 1/k 的概率替换。
+                    // 同分意味着交叉点数相同，每个起点被生成的次数也相同，所以仍是均匀的
+                    if (std::uniform_int_distribution<int>(0, ties++)(*rng) == 0) {
+                        bestRow = row;
+                        bestCol = col;
+                    }
+                } else if (row < bestRow || (row == bestRow && col < bestCol)) {
+                    // 得分相同时取行优先顺序中最靠前的位置
+                    bestRow = row;
+                    bestCol = col;
+                }
             }
         }
     }
@@ -142,32 +204,32 @@ int Board::evaluatePosition(const std::string& word, const int row, const int co
     // 检查单词前后是否有空间
     if (dir == Direction::Horizontal) {
         // 检查左边
-        if (col > 0 && grid_[row][col - 1] != '.') return 0;
+        if (col > 0 && at(row, col - 1) != '.') return 0;
         // 检查右边
-        if (col + wordLen < SIZE && grid_[row][col + wordLen] != '.') return 0;
+        if (col + wordLen < size_ && at(row, col + wordLen) != '.') return 0;
     } else {
         // 检查上边
-        if (row > 0 && grid_[row - 1][col] != '.') return 0;
+        if (row > 0 && at(row - 1, col) != '.') return 0;
         // 检查下边
-        if (row + wordLen < SIZE && grid_[row + wordLen][col] != '.') return 0;
+        if (row + wordLen < size_ && at(row + wordLen, col) != '.') return 0;
     }
 
     for (int i = 0; i < wordLen; ++i) {
         const int r = dir == Direction::Horizontal ? row : row + i;
         const int c = dir == Direction::Horizontal ? col + i : col;
-        const char boardChar = grid_[r][c];
+        const char boardChar = at(r, c);
         const char wordChar = word[i];
 
         if (boardChar == '.') {
             // 空位置 - 检查相邻位置
             if (dir == Direction::Horizontal) {
                 // 水平放置时检查上下
-                if (r > 0 && grid_[r - 1][c] != '.') return 0;
-                if (r < SIZE - 1 && grid_[r + 1][c] != '.') return 0;
+                if (r > 0 && at(r - 1, c) != '.') return 0;
+                if (r < size_ - 1 && at(r + 1, c) != '.') return 0;
             } else {
                 // 垂直放置时检查左右
-                if (c > 0 && grid_[r][c - 1] != '.') return 0;
-                if (c < SIZE - 1 && grid_[r][c + 1] != '.') return 0;
+                if (c > 0 && at(r, c - 1) != '.') return 0;
+                if (c < size_ - 1 && at(r, c + 1) != '.') return 0;
             }
         } else if (boardChar == wordChar) {
             // 字母匹配 - 交叉点
@@ -196,25 +258,44 @@ void Board::placeWord(const std::string& word, const int row, const int col, con
     for (int i = 0; i < wordLen; ++i) {
         const int r = dir == Direction::Horizontal ? row : row + i;
         const int c = dir == Direction::Horizontal ? col + i : col;
-        grid_[r][c] = word[i];
+        writeCell(r, c, word[i]);
     }
 
     placedWords_.push_back({word, row + 1, col + 1, dir});  // 转换为1-based索引
     placedCount_++;
 }
 
+Board::Quality Board::evaluate() const {
+    // 交叉格同时属于两个单词：单词总长度减去字母格数即为交叉格数
+    int letters = 0;
+    for (const char c : grid_) {
+        if (c != '.') letters++;
+    }
+    int totalLength = 0;
+    for (const auto& placed : placedWords_) {
+        totalLength += static_cast<int>(placed.word.length());
+    }
+
+    Quality q{};
+    q.placed = placedCount_;
+    q.intersections = totalLength - letters;
+    q.density = static_cast<double>(letters) / static_cast<double>(grid_.size());
+    q.score = q.placed * 10.0 + q.intersections * 5.0 + q.density * 100.0;
+    return q;
+}
+
 void Board::printSolution() const {
     std::cout << "\n===== 解答 (Solution) =====\n\n";
     std::cout << "   ";
-    for (int c = 1; c <= SIZE; ++c) {
+    for (int c = 1; c <= size_; ++c) {
         std::cout << std::setw(2) << c << " ";
     }
     std::cout << "\n";
 
-    for (int r = 0; r < SIZE; ++r) {
+    for (int r = 0; r < size_; ++r) {
         std::cout << std::setw(2) << (r + 1) << " ";
-        for (int c = 0; c < SIZE; ++c) {
-            std::cout << " " << grid_[r][c] << " ";
+        for (int c = 0; c < size_; ++c) {
+            std::cout << " " << at(r, c) << " ";
         }
         std::cout << "\n";
     }
@@ -223,16 +304,16 @@ void Board::printSolution() const {
 void Board::printPuzzle() const {
     std::cout << "\n===== 谜题 (Puzzle) =====\n\n";
     std::cout << "   ";
-    for (int c = 1; c <= SIZE; ++c) {
+    for (int c = 1; c <= size_; ++c) {
         std::cout << std::setw(2) << c << " ";
     }
     std::cout << "\n";
 
-    for (int r = 0; r < SIZE; ++r) {
+    for (int r = 0; r < size_; ++r) {
         std::cout << std::setw(2) << (r + 1) << " ";
 
-        for (int c = 0; c < SIZE; ++c) {
-            if (const char ch = grid_[r][c];ch == '.') {
+        for (int c = 0; c < size_; ++c) {
+            if (const char ch = at(r, c);ch == '.') {
                 std::cout << " . ";
             } else {
                 std::cout << " # ";  // 隐藏答案
@@ -2,7 +2,7 @@
  * board.h
  * 填字谜生成器 - Board 类声明
  *
- * 功能：管理15x15的填字谜棋盘，支持单词放置和显示
+ * 功能：管理任意大小（默认15x15）的填字谜棋盘，支持单词放置和显示
  */
 
 #pragma once
@@ -10,11 +10,13 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <random>
 
 class Board {
 public:
-    static constexpr int SIZE = 15;
-    static constexpr int MAX_WORDS = 20;
+    static constexpr int DEFAULT_SIZE = 15;
+    static constexpr int DEFAULT_MAX_WORDS = 20;
+    static constexpr int MAX_SIZE = 1000;  // 命令行接受的最大边长
 
     // 单词方向
     enum class Direction { Horizontal, Vertical };
@@ -27,7 +29,13 @@ public:
         Direction dir;
     };
 
-    Board();
+    explicit Board(int size = DEFAULT_SIZE, int maxWords = DEFAULT_MAX_WORDS);
+
+    // 棋盘边长
+    [[nodiscard]] int getSize() const { return size_; }
+
+    // 最多放置的单词数量
+    [[nodiscard]] int getMaxWords() const { return maxWords_; }
 
     // 获取指定位置的字符
     [[nodiscard]] char getSpot(int row, int col) const;
@@ -35,9 +43,26 @@ public:
     // 设置指定位置的字符
     void setSpot(int row, int col, char c);
 
+    // 放置质量评估
+    struct Quality {
+        int placed;         // 放置的单词数
+        int intersections;  // 交叉格数
+        double density;     // 字母格占全部格子的比例
+        double score;       // 综合得分，越高越好
+    };
+
     // 放置单词列表（自动排列）
     void placeWords(std::vector<std::string>& words);
 
+    // 放置单词列表，用 seed 打乱同长度单词的顺序，同分位置随机选择
+    void placeWords(std::vector<std::string>& words, unsigned seed);
+
+    // 评估当前棋盘的质量
+    [[nodiscard]] Quality evaluate() const;
+
+    // 在指定位置放置单词（不做检查，row/col 从 0 开始）
+    void placeWord(const std::string& word, int row, int col, Direction dir);
+
     // 打印完整解答
     void printSolution() const;
 
@@ -54,25 +79,44 @@ public:
     [[nodiscard]] const std::vector<PlacedWord>& getPlacedWords() const { return placedWords_; }
 
 private:
-    // 15x15 棋盘
-    std::array<std::array<char, SIZE>, SIZE> grid_;
+    int size_;
+    int maxWords_;
+
+    // size_ x size_ 棋盘，按行存放
+    std::vector<char> grid_;
+
+    // 字母位置索引：letterCells_[c - 'A'] 为该字母所在的格子编号（row * size_ + col）
+    std::array<std::vector<int>, 26> letterCells_;
 
     // 已放置的单词信息
     std::vector<PlacedWord> placedWords_;
     int placedCount_ = 0;
 
+    // 访问格子
+    [[nodiscard]] char& at(int row, int col) { return grid_[row * size_ + col]; }
+    [[nodiscard]] char at(int row, int col) const { return grid_[row * size_ + col]; }
+
+    // 更新格子并维护字母位置索引
+    void writeCell(int row, int col, char c);
+
+    // 按长度排好序的单词逐个放置，rng 非空时同分位置随机选择
+    void placeSorted(const std::vector<std::string>& words, std::mt19937* rng);
+
     // 尝试水平放置单词，返回最佳位置的得分
-    int tryPlaceHorizontal(const std::string& word, int& bestRow, int& bestCol) const;
+    // 只检查与已有字母相交的位置（由字母位置索引生成）
+    int tryPlaceHorizontal(const std::string& word, int& bestRow, int& bestCol, std::mt19937* rng) const;
 
     // 尝试垂直放置单词，返回最佳位置的得分
-    int tryPlaceVertical(const std::string& word, int& bestRow, int& bestCol) const;
+    int tryPlaceVertical(const std::string& word, int& bestRow, int& bestCol, std::mt19937* rng) const;
+
+    // 在相交位置中选出得分最高的，得分相同时取行列最小的（与逐格扫描的结果一致），
+    // 给了 rng 时在同分位置中均匀随机选一个
+    int tryPlaceAtIntersections(const std::string& word, Direction dir, int& bestRow, int& bestCol,
+                                std::mt19937* rng) const;
 
     // 检查单词是否可以放置在指定位置
     [[nodiscard]] int evaluatePosition(const std::string& word, int row, int col, Direction dir) const;
 
-    // 在指定位置放置单词
-    void placeWord(const std::string& word, int row, int col, Direction dir);
-
     // 生成字谜（打乱字母顺序）
     static std::string scramble(const std::string& word);
 
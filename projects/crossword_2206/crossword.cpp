@@ -6,19 +6,35 @@
  *   ./crossword                      交互式输入单词
  *   ./crossword words.txt            从文件读取单词
  *   ./crossword words.txt output.txt 输出到文件
+ *   ./crossword --fill grid.txt dict.txt  按模板从词典中选词填满棋盘
+ *
+ * 选项（放在文件名之前）:
+ *   --size N       棋盘边长（默认 15）
+ *   --max-words M  最多放置的单词数（默认 20）
+ *   --fill T       按模板文件 T 填充（# 为黑格，. 为空格），输入文件作为词典
+ *   --batch K      并行生成 K 个不同的填字谜，输出得分最高的
+ *   --keep N       批量生成时列出前 N 名（默认 5）
+ *   --threads T    批量生成使用的线程数（默认全部硬件线程）
  */
 
 #include "board.h"
+#include "batch_generator.h"
+#include "grid_filler.h"
+#include "word_list.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <string>
 #include <algorithm>
 #include <cctype>
+#include <cstring>
+#include <exception>
+#include <charconv>
+#include <iomanip>
 
 // 验证单词是否有效（只包含字母）
-bool isValidWord(const std::string& word) {
-    if (word.empty() || word.length() > Board::SIZE) {
+bool isValidWord(const std::string& word, const int size) {
+    if (word.empty() || word.length() > static_cast<size_t>(size)) {
         return false;
     }
     return std::all_of(word.begin(), word.end(),
@@ -26,53 +42,73 @@ bool isValidWord(const std::string& word) {
 }
 
 // 从标准输入读取单词
-std::vector<std::string> readWordsFromInput() {
+std::vector<std::string> readWordsFromInput(const int size, const int maxWords) {
     std::vector<std::string> words;
 
     std::cout << "===== 填字谜生成器 (Crossword Generator) =====\n\n";
-    std::cout << "请输入单词（每行一个，最多 " << Board::MAX_WORDS << " 个）:\n";
+    std::cout << "请输入单词（每行一个，最多 " << maxWords << " 个）:\n";
     std::cout << "输入 '.' 或按 Ctrl+D 结束输入\n\n";
 
     std::string word;
-    while (words.size() < Board::MAX_WORDS && std::cin >> word) {
+    while (words.size() < static_cast<size_t>(maxWords) && std::cin >> word) {
         if (word == ".") break;
 
-        if (!isValidWord(word)) {
+        if (!isValidWord(word, size)) {
             std::cerr << "警告: '" << word << "' 无效（只能包含字母且长度不超过 "
-                      << Board::SIZE << "），已跳过\n";
+                      << size << "），已跳过\n";
             continue;
         }
 
         words.push_back(word);
-        std::cout << "  已添加: " << word << " (" << words.size() << "/" << Board::MAX_WORDS << ")\n";
+        std::cout << "  已添加: " << word << " (" << words.size() << "/" << maxWords << ")\n";
     }
 
     return words;
 }
 
 // 从文件读取单词
-std::vector<std::string> readWordsFromFile(const std::string& filename) {
+std::vector<std::string> readWordsFromFile(const std::string& filename, const int size,
+                                           const int maxWords) {
     std::vector<std::string> words;
-    std::ifstream infile(filename);
+    WordList list;
 
-    if (!infile) {
+    if (!list.load(filename)) {
         std::cerr << "错误: 无法打开文件 '" << filename << "'\n";
         return words;
     }
 
-    std::string word;
-    while (words.size() < Board::MAX_WORDS && infile >> word) {
-        if (!isValidWord(word)) {
-            std::cerr << "警告: '" << word << "' 无效，已跳过\n";
+    for (const auto& token : list.getTokens()) {
+        if (words.size() >= static_cast<size_t>(maxWords)) break;
+
+        if (!token.valid || token.length > static_cast<uint32_t>(size)) {
+            std::cerr << "警告: '" << list.text(token) << "' 无效，已跳过\n";
             continue;
         }
-        words.push_back(word);
+        words.emplace_back(list.text(token));
     }
 
     std::cout << "从文件 '" << filename << "' 读取了 " << words.size() << " 个单词\n";
     return words;
 }
 
+// 读取棋盘模板（忽略空行）
+std::vector<std::string> readTemplate(const std::string& filename) {
+    std::vector<std::string> rows;
+    std::ifstream infile(filename);
+
+    if (!infile) {
+        std::cerr << "错误: 无法打开模板文件 '" << filename << "'\n";
+        return rows;
+    }
+
+    std::string line;
+    while (std::getline(infile, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) rows.push_back(line);
+    }
+    return rows;
+}
+
 // 输出结果
 void outputResults(Board& board, std::ostream& out, bool isFile = false) {
     // 保存和重定向 cout
@@ -102,21 +138,165 @@ void showUsage(const char* progName) {
     std::cout << "  " << progName << "                      交互式输入单词\n";
     std::cout << "  " << progName << " <输入文件>           从文件读取单词\n";
     std::cout << "  " << progName << " <输入文件> <输出文件> 输出结果到文件\n";
+    std::cout << "  " << progName << " --fill <模板文件> <词典文件> [输出文件] 按模板填充\n";
+    std::cout << "选项（放在文件名之前）:\n";
+    std::cout << "  --size N       棋盘边长（默认 " << Board::DEFAULT_SIZE << "，最大 " << Board::MAX_SIZE << "）\n";
+    std::cout << "  --max-words M  最多放置的单词数（默认 " << Board::DEFAULT_MAX_WORDS << "）\n";
+    std::cout << "  --fill T       按模板文件 T 填充（# 为黑格，. 为空格）\n";
+    std::cout << "  --batch K      并行生成 K 个不同的填字谜，输出得分最高的\n";
+    std::cout << "  --keep N       批量生成时列出前 N 名（默认 5）\n";
+    std::cout << "  --threads T    批量生成使用的线程数（默认全部硬件线程，最多 " << BatchGenerator::MAX_THREADS
+              << "）\n";
+}
+
+// 解析正整数参数
+bool parsePositive(const char* text, int& value) {
+    const char* end = text + std::strlen(text);
+    const auto [ptr, ec] = std::from_chars(text, end, value);
+    return ec == std::errc() && ptr == end && value > 0;
+}
+
+// 批量生成，列出前几名并返回最好的棋盘
+Board generateBatch(const std::vector<std::string>& words, const int size, const int maxWords,
+                    const int attempts, const int keep, const unsigned threads) {
+    const BatchGenerator generator(words, size, maxWords);
+    std::vector<BatchGenerator::Result> results = generator.run(attempts, std::max(keep, 1), threads);
+
+    const std::ios::fmtflags flags = std::cout.flags();
+    const std::streamsize precision = std::cout.precision();
+
+    // 中文标题每个字占 3 字节、2 列宽，所以标题的 setw 比数据列多 2
+    std::cout << "\n===== 批量生成 (Batch) : " << attempts << " 次尝试 =====\n\n";
+    std::cout << std::left << std::setw(8) << "名次"
+              << std::setw(10) << "种子"
+              << std::setw(10) << "单词"
+              << std::setw(10) << "交叉"
+              << std::setw(12) << "密度"
+              << "得分\n";
+    std::cout << std::string(50, '-') << "\n";
+
+    for (size_t i = 0; i < results.size() && i < static_cast<size_t>(keep); ++i) {
+        const auto& [seed, board, quality] = results[i];
+        std::cout << std::left << std::setw(6) << i + 1
+                  << std::setw(8) << seed
+                  << std::setw(8) << quality.placed
+                  << std::setw(8) << quality.intersections
+                  << std::setw(10) << std::fixed << std::setprecision(3) << quality.density
+                  << std::setprecision(1) << quality.score << "\n";
+    }
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+
+    return std::move(results.front().board);
+}
+
+// 写出结果，outputFile 为空时输出到屏幕
+int writeResults(Board& board, const char* outputFile) {
+    if (outputFile != nullptr) {
+        std::ofstream outfile(outputFile);
+        if (!outfile) {
+            std::cerr << "错误: 无法创建输出文件 '" << outputFile << "'\n";
+            return 1;
+        }
+        outputResults(board, outfile, true);
+        std::cout << "结果已保存到 '" << outputFile << "'\n";
+    } else {
+        outputResults(board, std::cout);
+    }
+    return 0;
+}
+
+// 按模板从词典中选词填满棋盘
+int fillTemplate(const char* templateFile, const char* dictFile, const char* outputFile) {
+    const std::vector<std::string> pattern = readTemplate(templateFile);
+    if (pattern.empty()) return 1;
+
+    const int size = static_cast<int>(pattern.size());
+    for (const auto& row : pattern) {
+        if (static_cast<int>(row.length()) != size) {
+            std::cerr << "错误: 模板必须是正方形（" << size << " 行，每行 " << size << " 个字符）\n";
+            return 1;
+        }
+    }
+
+    WordList dictionary;
+    if (!dictionary.load(dictFile)) {
+        std::cerr << "错误: 无法打开文件 '" << dictFile << "'\n";
+        return 1;
+    }
+
+    GridFiller filler(dictionary);
+    std::cout << "词典共 " << filler.getWordCount() << " 个单词\n";
+
+    Board board(size);
+    if (!filler.fill(pattern, board)) {
+        std::cerr << "错误: 无法用词典中的单词填满模板（搜索了 " << filler.getNodeCount() << " 个节点）\n";
+        return 1;
+    }
+    std::cout << "填充完成（搜索了 " << filler.getNodeCount() << " 个节点）\n";
+
+    return writeResults(board, outputFile);
 }
 
 int main(int argc, char* argv[]) {
     std::vector<std::string> words;
+    int size = Board::DEFAULT_SIZE;
+    int maxWords = Board::DEFAULT_MAX_WORDS;
+    const char* templateFile = nullptr;
+    int batch = 0;
+    int keep = 5;
+    int threads = 0;
+
+    // 解析选项
+    int argi = 1;
+    while (argi < argc && std::strncmp(argv[argi], "--", 2) == 0) {
+        if (argi + 1 >= argc) {
+            showUsage(argv[0]);
+            return 1;
+        }
+        bool valid = true;
+        if (std::strcmp(argv[argi], "--size") == 0) {
+            valid = parsePositive(argv[argi + 1], size) && size <= Board::MAX_SIZE;
+        } else if (std::strcmp(argv[argi], "--max-words") == 0) {
+            valid = parsePositive(argv[argi + 1], maxWords);
+        } else if (std::strcmp(argv[argi], "--batch") == 0) {
+            valid = parsePositive(argv[argi + 1], batch);
+        } else if (std::strcmp(argv[argi], "--keep") == 0) {
+            valid = parsePositive(argv[argi + 1], keep);
+        } else if (std::strcmp(argv[argi], "--threads") == 0) {
+            valid = parsePositive(argv[argi + 1], threads) && threads <= BatchGenerator::MAX_THREADS;
+        } else if (std::strcmp(argv[argi], "--fill") == 0) {
+            templateFile = argv[argi + 1];
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            showUsage(argv[0]);
+            return 1;
+        }
+        argi += 2;
+    }
+
+    const int positional = argc - argi;
+    const char* inputFile = positional >= 1 ? argv[argi] : nullptr;
+    const char* outputFile = positional == 2 ? argv[argi + 1] : nullptr;
+
+    // 模板填充模式
+    if (templateFile != nullptr) {
+        if (positional < 1 || positional > 2) {
+            showUsage(argv[0]);
+            return 1;
+        }
+        return fillTemplate(templateFile, inputFile, outputFile);
+    }
 
     // 根据参数决定输入方式
-    if (argc == 1) {
+    if (positional == 0) {
         // 交互式输入
-        words = readWordsFromInput();
-    } else if (argc == 2) {
-        // 从文件读取
-        words = readWordsFromFile(argv[1]);
-    } else if (argc == 3) {
-        // 从文件读取，输出到文件
-        words = readWordsFromFile(argv[1]);
+        words = readWordsFromInput(size, maxWords);
+    } else if (positional <= 2) {
+        // 从文件读取（可选输出到文件）
+        words = readWordsFromFile(inputFile, size, maxWords);
     } else {
         showUsage(argv[0]);
         return 1;
@@ -127,22 +307,19 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    // 创建棋盘并放置单词
-    Board board;
-    board.placeWords(words);
-
-    // 输出结果
-    if (argc == 3) {
-        std::ofstream outfile(argv[2]);
-        if (!outfile) {
-            std::cerr << "错误: 无法创建输出文件 '" << argv[2] << "'\n";
-            return 1;
+    try {
+        // 创建棋盘并放置单词
+        Board board(size, maxWords);
+        if (batch > 0) {
+            board = generateBatch(words, size, maxWords, batch, keep, static_cast<unsigned>(threads));
+        } else {
+            board.placeWords(words);
         }
-        outputResults(board, outfile, true);
-        std::cout << "结果已保存到 '" << argv[2] << "'\n";
-    } else {
-        outputResults(board, std::cout);
-    }
 
-    return 0;
+        // 输出结果
+        return writeResults(board, outputFile);
+    } catch (const std::exception& e) {
+        std::cerr << "错误: " << e.what() << "\n";
+        return 1;
+    }
 }
@@ -0,0 +1,299 @@
+/**
+ * grid_filler.cpp
+ * 填字谜生成器 - GridFiller 类实现
+ */
+
+#include "grid_filler.h"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <limits>
+#include <ranges>
+#include <unordered_set>
+
+GridFiller::GridFiller(const WordList& dictionary) {
+    index_.resize(dictionary.getMaxLength() + 1);
+
+    for (size_t len = 1; len < index_.size(); ++len) {
+        std::unordered_set<std::string_view> seen;
+        for (const auto& entry : dictionary.getWordsOfLength(len)) {
+            if (const std::string_view word = dictionary.text(entry); seen.insert(word).second) {
+                index_[len].words.emplace_back(word);
+            }
+        }
+    }
+
+    for (size_t len = 1; len < index_.size(); ++len) {
+        auto& [words, letterBits, all] = index_[len];
+        if (words.empty()) continue;
+
+        // 按各位置字母的出现频率给单词打分，常见字母多的单词排在前面，
+        // 这样先尝试的单词给相交槽位留下的候选更多
+        std::vector<int> freq(len * 26, 0);
+        for (const auto& word : words) {
+            for (size_t i = 0; i < len; ++i) {
+                freq[i * 26 + (word[i] - 'A')]++;
+            }
+        }
+        std::vector<std::pair<long long, size_t>> order;
+        order.reserve(words.size());
+        for (size_t w = 0; w < words.size(); ++w) {
+            long long score = 0;
+            for (size_t i = 0; i < len; ++i) {
+                score += freq[i * 26 + (words[w][i] - 'A')];
+            }
+            order.emplace_back(-score, w);
+        }
+        std::ranges::sort(order);
+
+        std::vector<std::string> sorted;
+        sorted.reserve(words.size());
+        for (const auto& w : order | std::views::values) {
+            sorted.push_back(std::move(words[w]));
+        }
+        words = std::move(sorted);
+
+        // 建立 (位置, 字母) 位集索引
+        const size_t blocks = (words.size() + 63) / 64;
+        all.assign(blocks, 0);
+        letterBits.assign(len * 26, Bits(blocks, 0));
+        for (size_t w = 0; w < words.size(); ++w) {
+            const uint64_t bit = uint64_t{1} << (w % 64);
+            all[w / 64] |= bit;
+            for (size_t i = 0; i < len; ++i) {
+                letterBits[i * 26 + (words[w][i] - 'A')][w / 64] |= bit;
+            }
+        }
+    }
+}
+
+size_t GridFiller::getWordCount() const {
+    size_t total = 0;
+    for (const auto& entry : index_) {
+        total += entry.words.size();
+    }
+    return total;
+}
+
+bool GridFiller::fill(const std::vector<std::string>& pattern, Board& board) {
+    nodeCount_ = 0;
+    size_ = board.getSize();
+    if (static_cast<int>(pattern.size()) != size_) return false;
+    if (!buildSlots(pattern)) return false;
+
+    // 初始候选集：同长度的全部单词，再按预先给定的字母过滤
+    const size_t slotCount = slots_.size();
+    domains_.assign(slotCount, {});
+    counts_.assign(slotCount, 0);
+    assigned_.assign(slotCount, -1);
+    domainTrail_.clear();
+    cellTrail_.clear();
+    slotsByLength_.assign(index_.size(), {});
+
+    for (size_t s = 0; s < slotCount; ++s) {
+        const Slot& slot = slots_[s];
+        if (slot.length >= static_cast<int>(index_.size()) || index_[slot.length].words.empty()) {
+            return false;
+        }
+        const LengthIndex& entry = index_[slot.length];
+        slotsByLength_[slot.length].push_back(static_cast<int>(s));
+
+        domains_[s] = entry.all;
+        for (int i = 0; i < slot.length; ++i) {
+            if (const char c = grid_[slot.cells[i]]; c != '.') {
+                const Bits& mask = entry.letterBits[i * 26 + (c - 'A')];
+                for (size_t k = 0; k < mask.size(); ++k) {
+                    domains_[s][k] &= mask[k];
+                }
+            }
+        }
+        counts_[s] = popcount(domains_[s]);
+        if (counts_[s] == 0) return false;
+    }
+
+    // 回溯搜索的耗时是长尾分布：开头几步选错时会在很大的子树里打转。
+    // 因此限制每轮的节点数，超出后换一个随机顺序重来，限额每轮翻倍，
+    // 最后一轮总能把搜索空间走完
+    bool found = false;
+    for (int round = 0; !found; ++round) {
+        nodeLimit_ = round < MAX_DOUBLINGS ? nodeCount_ + (RESTART_NODES << round)
+                                           : std::numeric_limits<long long>::max();
+        shuffle_ = round > 0;
+        rng_.seed(round);
+
+        found = search();
+        if (!found && nodeCount_ < nodeLimit_) return false;  // 走完了整个搜索空间，无解
+    }
+
+    // 把结果写到棋盘上
+    for (size_t s = 0; s < slotCount; ++s) {
+        const Slot& slot = slots_[s];
+        board.placeWord(index_[slot.length].words[assigned_[s]], slot.row, slot.col, slot.dir);
+    }
+    return true;
+}
+
+bool GridFiller::buildSlots(const std::vector<std::string>& pattern) {
+    grid_.assign(static_cast<size_t>(size_) * size_, '#');
+    for (int r = 0; r < size_; ++r) {
+        if (static_cast<int>(pattern[r].length()) != size_) return false;
+        for (int c = 0; c < size_; ++c) {
+            const char ch = pattern[r][c];
+            if (ch == '#') continue;
+            if (ch == '.' || ch == '?') {
+                grid_[r * size_ + c] = '.';
+            } else if (std::isalpha(static_cast<unsigned char>(ch))) {
+                grid_[r * size_ + c] = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+            } else {
+                return false;
+            }
+        }
+    }
+
+    slots_.clear();
+    cellSlots_.assign(grid_.size(), {});
+
+    for (const auto dir : {Board::Direction::Horizontal, Board::Direction::Vertical}) {
+        const int d = dir == Board::Direction::Horizontal ? 0 : 1;
+        for (int line = 0; line < size_; ++line) {
+            int start = 0;
+            while (start < size_) {
+                // 找到一段连续的非黑格
+                int end = start;
+                auto cellAt = [&](const int k) { return d == 0 ? line * size_ + k : k * size_ + line; };
+                while (end < size_ && grid_[cellAt(end)] != '#') ++end;
+
+                if (end - start >= 2) {
+                    Slot slot{d == 0 ? line : start, d == 0 ? start : line, dir, end - start, {}};
+                    for (int k = start; k < end; ++k) {
+                        cellSlots_[cellAt(k)][d] = {static_cast<int>(slots_.size()), k - start};
+                        slot.cells.push_back(cellAt(k));
+                    }
+                    slots_.push_back(std::move(slot));
+                }
+                start = end + 1;
+            }
+        }
+    }
+    return true;
+}
+
+bool GridFiller::search() {
+    ++nodeCount_;
+
+    // 选候选最少的未填槽位，相同时选较长的
+    int best = -1;
+    for (size_t s = 0; s < slots_.size(); ++s) {
+        if (assigned_[s] >= 0) continue;
+        if (best < 0 || counts_[s] < counts_[best] ||
+            (counts_[s] == counts_[best] && slots_[s].length > slots_[best].length)) {
+            best = static_cast<int>(s);
+        }
+    }
+    if (best < 0) return true;  // 全部填满
+
+    // 取出候选单词（回溯时候选集会被修改和恢复，所以先复制出来）
+    std::vector<int> candidates;
+    candidates.reserve(counts_[best]);
+    const Bits& domain = domains_[best];
+    for (size_t k = 0; k < domain.size(); ++k) {
+        for (uint64_t bits = domain[k]; bits != 0; bits &= bits - 1) {
+            candidates.push_back(static_cast<int>(k * 64 + std::countr_zero(bits)));
+        }
+    }
+
+    // 重启后在小窗口内打乱顺序，大体上仍然先试常见字母多的单词
+    if (shuffle_) {
+        const size_t n = candidates.size();
+        for (size_t i = 0; i + 1 < n; ++i) {
+            std::uniform_int_distribution<size_t> pick(i, std::min(n, i + SHUFFLE_WINDOW) - 1);
+            std::swap(candidates[i], candidates[pick(rng_)]);
+        }
+    }
+
+    for (const int word : candidates) {
+        if (nodeCount_ >= nodeLimit_) return false;
+
+        const size_t domainMark = domainTrail_.size();
+        const size_t cellMark = cellTrail_.size();
+        if (assign(best, word) && search()) return true;
+        undo(best, domainMark, cellMark);
+    }
+    return false;
+}
+
+bool GridFiller::assign(const int slot, const int word) {
+    const Slot& s = slots_[slot];
+    const LengthIndex& entry = index_[s.length];
+    const std::string& text = entry.words[word];
+    const int d = s.dir == Board::Direction::Horizontal ? 0 : 1;
+
+    assigned_[slot] = word;
+
+    // 写入新字母，相交的未填槽位只保留该位置字母相同的单词
+    for (int i = 0; i < s.length; ++i) {
+        const int cell = s.cells[i];
+        if (grid_[cell] != '.') continue;
+
+        grid_[cell] = text[i];
+        cellTrail_.push_back(cell);
+
+        const auto [other, pos] = cellSlots_[cell][1 - d];
+        if (other < 0 || assigned_[other] >= 0) continue;
+        if (!narrow(other, index_[slots_[other].length].letterBits[pos * 26 + (text[i] - 'A')])) {
+            return false;
+        }
+    }
+
+    // 同一个单词不能出现两次
+    for (const int other : slotsByLength_[s.length]) {
+        if (assigned_[other] < 0 && !exclude(other, word)) return false;
+    }
+
+    return true;
+}
+
+void GridFiller::undo(const int slot, const size_t domainMark, const size_t cellMark) {
+    while (domainTrail_.size() > domainMark) {
+        auto& [s, count, domain] = domainTrail_.back();
+        domains_[s] = std::move(domain);
+        counts_[s] = count;
+        domainTrail_.pop_back();
+    }
+    while (cellTrail_.size() > cellMark) {
+        grid_[cellTrail_.back()] = '.';
+        cellTrail_.pop_back();
+    }
+    assigned_[slot] = -1;
+}
+
+bool GridFiller::narrow(const int slot, const Bits& mask) {
+    Bits& domain = domains_[slot];
+    domainTrail_.push_back({slot, counts_[slot], domain});
+
+    int count = 0;
+    for (size_t k = 0; k < domain.size(); ++k) {
+        domain[k] &= mask[k];
+        count += std::popcount(domain[k]);
+    }
+    counts_[slot] = count;
+    return count > 0;
+}
+
+bool GridFiller::exclude(const int slot, const int word) {
+    Bits& domain = domains_[slot];
+    const uint64_t bit = uint64_t{1} << (word % 64);
+    if ((domain[word / 64] & bit) == 0) return true;
+
+    domainTrail_.push_back({slot, counts_[slot], domain});
+    domain[word / 64] &= ~bit;
+    return --counts_[slot] > 0;
+}
+
+int GridFiller::popcount(const Bits& bits) {
+    int count = 0;
+    for (const uint64_t b : bits) {
+        count += std::popcount(b);
+    }
+    return count;
+}
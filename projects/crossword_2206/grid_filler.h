@@ -0,0 +1,109 @@
+/**
+ * grid_filler.h
+ * 填字谜生成器 - GridFiller 类声明
+ *
+ * 功能：按给定的棋盘模板（# 为黑格）从词典中选词填满所有空格
+ */
+
+#pragma once
+
+#include "board.h"
+#include "word_list.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <array>
+#include <random>
+
+class GridFiller {
+public:
+    // 用词典构造，重复的单词只保留一个
+    explicit GridFiller(const WordList& dictionary);
+
+    // 按模板填充棋盘：'#' 为黑格，'.' 或 '?' 为待填空格，字母为预先给定的格子
+    // 模板必须是与 board 同样大小的正方形；成功时把每个槽位的单词放到 board 上
+    bool fill(const std::vector<std::string>& pattern, Board& board);
+
+    // 词典中的单词数量
+    [[nodiscard]] size_t getWordCount() const;
+
+    // 上一次填充访问的搜索节点数
+    [[nodiscard]] long long getNodeCount() const { return nodeCount_; }
+
+private:
+    using Bits = std::vector<uint64_t>;
+
+    // 同一长度的全部单词及其 (位置, 字母) 位集索引
+    // 模式 ?A??E 的候选集 = letterBits[1*26+'A'] & letterBits[4*26+'E']
+    struct LengthIndex {
+        std::vector<std::string> words;
+        std::vector<Bits> letterBits;  // letterBits[pos * 26 + letter]
+        Bits all;
+    };
+
+    // 槽位：同一方向上一段长度至少为 2 的连续空格
+    struct Slot {
+        int row;
+        int col;
+        Board::Direction dir;
+        int length;
+        std::vector<int> cells;  // 每个字母所在的格子编号
+    };
+
+    // 格子在某个方向上所属的槽位
+    struct CellLink {
+        int slot = -1;
+        int pos = 0;
+    };
+
+    // 回溯时需要恢复的候选集
+    struct SavedDomain {
+        int slot;
+        int count;
+        Bits domain;
+    };
+
+    // 按长度分组的词典索引
+    std::vector<LengthIndex> index_;
+
+    // 以下为一次填充的搜索状态
+    int size_ = 0;
+    std::vector<char> grid_;
+    std::vector<Slot> slots_;
+    std::vector<std::array<CellLink, 2>> cellSlots_;  // [0] 横向，[1] 纵向
+    std::vector<std::vector<int>> slotsByLength_;
+    std::vector<Bits> domains_;
+    std::vector<int> counts_;
+    std::vector<int> assigned_;  // 已选单词编号，未选为 -1
+    std::vector<SavedDomain> domainTrail_;
+    std::vector<int> cellTrail_;
+    long long nodeCount_ = 0;
+
+    // 随机重启
+    static constexpr long long RESTART_NODES = 1000;
+    static constexpr int MAX_DOUBLINGS = 24;
+    static constexpr size_t SHUFFLE_WINDOW = 8;
+    long long nodeLimit_ = 0;
+    bool shuffle_ = false;
+    std::mt19937 rng_;
+
+    // 从模板中找出所有槽位
+    bool buildSlots(const std::vector<std::string>& pattern);
+
+    // 回溯搜索：每次选候选最少的槽位（MRV）
+    bool search();
+
+    // 把单词 word 填入槽位，并对相交槽位和同长度槽位做前向检查
+    bool assign(int slot, int word);
+
+    // 撤销到指定的回溯点
+    void undo(int slot, size_t domainMark, size_t cellMark);
+
+    // 缩小槽位的候选集（先保存旧值）
+    bool narrow(int slot, const Bits& mask);
+
+    // 从槽位的候选集中去掉一个单词
+    bool exclude(int slot, int word);
+
+    static int popcount(const Bits& bits);
+};
@@ -0,0 +1,215 @@
+/**
+ * word_list.cpp
+ * 填字谜生成器 - WordList 类实现
+ */
+
+#include "word_list.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// 与 std::isspace 相同：空格以及 \t \n \v \f \r
+bool isSpace(const char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// 单字节的分类：写出大写形式，返回 (是否空白, 是否字母)
+void classifyByte(const char c, char& out, bool& space, bool& alpha) {
+    out = c >= 'a' && c <= 'z' ? static_cast<char>(c - ('a' - 'A')) : c;
+    space = isSpace(c);
+    alpha = out >= 'A' && out <= 'Z';
+}
+
+// 把 n 字节转为大写写入 dst，同时按位记录每个字节是否为空白、是否为字母
+// 末尾不足 64 字节的部分按空白补齐
+void classify(const char* src, char* dst, const size_t n, uint64_t* space, uint64_t* alpha) {
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    // 每次处理 64 字节（4 个 16 字节向量），得到一个 64 位的掩码
+    const __m128i lowerMin = _mm_set1_epi8('a' - 1);
+    const __m128i lowerMax = _mm_set1_epi8('z' + 1);
+    const __m128i upperMin = _mm_set1_epi8('A' - 1);
+    const __m128i upperMax = _mm_set1_epi8('Z' + 1);
+    const __m128i caseBit = _mm_set1_epi8('a' - 'A');
+    const __m128i blank = _mm_set1_epi8(' ');
+    const __m128i controlMin = _mm_set1_epi8('\t' - 1);
+    const __m128i controlMax = _mm_set1_epi8('\r' + 1);
+
+    for (; i + 64 <= n; i += 64) {
+        uint64_t spaceMask = 0;
+        uint64_t alphaMask = 0;
+        for (int part = 0; part < 4; ++part) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + part * 16));
+
+            // 字节按有符号比较，>= 0x80 的字节为负数，不会落在字母范围内
+            const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(v, lowerMin), _mm_cmplt_epi8(v, lowerMax));
+            const __m128i upper = _mm_sub_epi8(v, _mm_and_si128(lower, caseBit));
+            const __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(upper, upperMin), _mm_cmplt_epi8(upper, upperMax));
+            const __m128i isBlank = _mm_or_si128(
+                _mm_cmpeq_epi8(v, blank),
+                _mm_and_si128(_mm_cmpgt_epi8(v, controlMin), _mm_cmplt_epi8(v, controlMax)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + part * 16), upper);
+            spaceMask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(isBlank))) << (part * 16);
+            alphaMask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(isAlpha))) << (part * 16);
+        }
+        space[i / 64] = spaceMask;
+        alpha[i / 64] = alphaMask;
+    }
+#endif
+
+    // 剩余部分（或不支持 SSE2 时的全部）逐字节处理
+    for (; i < n; i += 64) {
+        uint64_t spaceMask = ~uint64_t{0};
+        uint64_t alphaMask = 0;
+        for (size_t j = 0; j < 64 && i + j < n; ++j) {
+            bool isBlank;
+            bool isAlpha;
+            classifyByte(src[i + j], dst[i + j], isBlank, isAlpha);
+            if (!isBlank) spaceMask &= ~(uint64_t{1} << j);
+            if (isAlpha) alphaMask |= uint64_t{1} << j;
+        }
+        space[i / 64] = spaceMask;
+        alpha[i / 64] = alphaMask;
+    }
+}
+
+// 从 from 开始找第一个值为 value 的位，找不到返回 n
+size_t nextBit(const std::vector<uint64_t>& bits, const size_t from, const bool value, const size_t n) {
+    size_t k = from / 64;
+    if (k >= bits.size()) return n;
+
+    uint64_t word = (value ? bits[k] : ~bits[k]) & (~uint64_t{0} << (from % 64));
+    while (word == 0) {
+        if (++k == bits.size()) return n;
+        word = value ? bits[k] : ~bits[k];
+    }
+    return std::min(n, k * 64 + std::countr_zero(word));
+}
+
+// [begin, end) 内的位是否全为 1
+bool allSet(const std::vector<uint64_t>& bits, size_t begin, const size_t end) {
+    while (begin < end) {
+        const size_t offset = begin % 64;
+        const size_t count = std::min<size_t>(64 - offset, end - begin);
+        const uint64_t mask = (count == 64 ? ~uint64_t{0} : (uint64_t{1} << count) - 1) << offset;
+        if ((bits[begin / 64] & mask) != mask) return false;
+        begin += count;
+    }
+    return true;
+}
+
+} // namespace
+
+bool WordList::load(const std::string& filename) {
+    arena_.reset();
+    tokens_.clear();
+    byLength_.clear();
+    lengthStarts_.clear();
+
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    // 普通文件直接映射到内存
+    struct stat st {};
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        const auto size = static_cast<size_t>(st.st_size);
+        if (size > std::numeric_limits<uint32_t>::max()) {
+            ::close(fd);
+            return false;
+        }
+        if (size == 0) {
+            ::close(fd);
+            build(nullptr, 0);
+            return true;
+        }
+
+        if (void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0); map != MAP_FAILED) {
+            ::madvise(map, size, MADV_SEQUENTIAL);
+            build(static_cast<const char*>(map), size);
+            ::munmap(map, size);
+            ::close(fd);
+            return true;
+        }
+    }
+
+    // 管道等无法映射的输入：逐块读取
+    std::vector<char> buffer;
+    char chunk[1 << 16];
+    ssize_t got;
+    while ((got = ::read(fd, chunk, sizeof(chunk))) > 0) {
+        buffer.insert(buffer.end(), chunk, chunk + got);
+    }
+    ::close(fd);
+    if (got < 0 || buffer.size() > std::numeric_limits<uint32_t>::max()) return false;
+
+    build(buffer.data(), buffer.size());
+    return true;
+}
+
+std::span<const WordList::Entry> WordList::getWordsOfLength(const size_t length) const {
+    if (length == 0 || length + 1 >= lengthStarts_.size()) return {};
+    return std::span(byLength_).subspan(lengthStarts_[length],
+                                        lengthStarts_[length + 1] - lengthStarts_[length]);
+}
+
+void WordList::build(const char* data, const size_t size) {
+    // 整个文件转为大写后放进一块内存，同时得到空白和字母的位图
+    arena_ = std::make_unique_for_overwrite<char[]>(std::max<size_t>(size, 1));
+    std::vector<uint64_t> space((size + 63) / 64);
+    std::vector<uint64_t> alpha((size + 63) / 64);
+    classify(data, arena_.get(), size, space.data(), alpha.data());
+
+    // 词的个数 = 前一个字节为空白的非空白字节数，先数出来一次分配到位
+    size_t tokenCount = 0;
+    uint64_t carry = 1;
+    for (const uint64_t bits : space) {
+        tokenCount += std::popcount(~bits & ((bits << 1) | carry));
+        carry = bits >> 63;
+    }
+    tokens_.reserve(tokenCount);
+
+    // 按空白切分，只包含字母的词为有效单词
+    std::vector<size_t> counts;
+    for (size_t pos = nextBit(space, 0, false, size); pos < size;
+         pos = nextBit(space, pos, false, size)) {
+        const size_t end = nextBit(space, pos, true, size);
+        const auto length = static_cast<uint32_t>(end - pos);
+        const bool valid = allSet(alpha, pos, end);
+
+        if (valid) {
+            if (length >= counts.size()) counts.resize(length + 1, 0);
+            counts[length]++;
+        } else {
+            // 无效的词保留原文，便于报告
+            std::memcpy(arena_.get() + pos, data + pos, length);
+        }
+        tokens_.push_back({static_cast<uint32_t>(pos), length, valid});
+        pos = end;
+    }
+
+    // 按长度分组（计数排序，同长度内保持文件顺序）
+    lengthStarts_.assign(counts.size() + 1, 0);
+    for (size_t length = 0; length < counts.size(); ++length) {
+        lengthStarts_[length + 1] = lengthStarts_[length] + counts[length];
+    }
+    byLength_.resize(lengthStarts_.back());
+
+    std::vector<size_t> next(lengthStarts_.begin(), lengthStarts_.end() - 1);
+    for (const Entry& token : tokens_) {
+        if (token.valid) byLength_[next[token.length]++] = token;
+    }
+}
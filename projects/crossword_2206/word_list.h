@@ -0,0 +1,60 @@
+/**
+ * word_list.h
+ * 填字谜生成器 - WordList 类声明
+ *
+ * 功能：一次性加载整个单词文件，校验并转为大写后存放在一块连续内存中
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class WordList {
+public:
+    // 文件中的一个词（以空白分隔），offset/length 指向内部的连续内存
+    struct Entry {
+        uint32_t offset;
+        uint32_t length;
+        bool valid;  // 是否只包含字母
+    };
+
+    // 加载单词文件：普通文件用 mmap 映射，其他（管道等）逐块读取
+    // 失败时返回 false，原有内容被清空
+    bool load(const std::string& filename);
+
+    // 按文件顺序排列的全部词，包括无效的
+    [[nodiscard]] std::span<const Entry> getTokens() const { return tokens_; }
+
+    // 长度为 length 的有效单词（已转为大写，保持文件中的顺序）
+    [[nodiscard]] std::span<const Entry> getWordsOfLength(size_t length) const;
+
+    // 词的文本：有效单词为大写形式，无效的词保持原样
+    [[nodiscard]] std::string_view text(const Entry& entry) const {
+        return {arena_.get() + entry.offset, entry.length};
+    }
+
+    // 有效单词数量
+    [[nodiscard]] size_t size() const { return byLength_.size(); }
+
+    // 最长的有效单词长度
+    [[nodiscard]] size_t getMaxLength() const {
+        return lengthStarts_.size() < 2 ? 0 : lengthStarts_.size() - 2;
+    }
+
+private:
+    // 转为大写后的文件内容，所有 Entry 都指向这里
+    std::unique_ptr<char[]> arena_;
+    std::vector<Entry> tokens_;
+
+    // 按长度分组的有效单词：长度为 n 的在 [lengthStarts_[n], lengthStarts_[n + 1])
+    std::vector<Entry> byLength_;
+    std::vector<size_t> lengthStarts_;
+
+    // 从内存中的文件内容建立单词表
+    void build(const char* data, size_t size);
+};
@@ -0,0 +1,58 @@
+#include "frog-kjump.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+// 对不同的 N 和 K 比较标量和 SIMD 版本的 KJump
+// 用法: dp_frog_bench [最大 N]（默认 10^7）
+template<typename F> double seconds(F&& f) {
+    const auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    const size_t max_n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+    mt19937_64 rng(1);
+    uniform_int_distribution<int64_t> dist(0, 1'000'000);
+    vector<int64_t> h(max_n);
+    for (auto& x : h) {
+        x = dist(rng);
+    }
+
+    printf("%10s %5s %12s %12s %8s %14s\n", "N", "K", "scalar (ms)", "simd (ms)", "speedup", "simd ns/relax");
+    for (size_t n = 100'000; n <= max_n; n *= 10) {
+        for (const size_t k : {1, 2, 4, 8, 16, 32, 64, 128}) {
+            int64_t scalar_cost = 0;
+            int64_t simd_cost = 0;
+            const double scalar = seconds([&] {
+                frog::KJump solver(k, false);
+                for (size_t i = 0; i < n; ++i) {
+                    solver.push(h[i]);
+                }
+                scalar_cost = solver.cost();
+            });
+            const double simd = seconds([&] {
+                frog::KJump solver(k);
+                for (size_t i = 0; i < n; ++i) {
+                    solver.push(h[i]);
+                }
+                simd_cost = solver.cost();
+            });
+            if (scalar_cost != simd_cost) {
+                fprintf(stderr, "mismatch: N=%zu K=%zu %lld != %lld\n", n, k,
+                        static_cast<long long>(scalar_cost), static_cast<long long>(simd_cost));
+                return 1;
+            }
+            printf("%10zu %5zu %12.2f %12.2f %7.2fx %14.3f\n", n, k, scalar * 1e3, simd * 1e3, scalar / simd,
+                   simd * 1e9 / static_cast<double>(n * k));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include "frog-kjump.hpp"
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+// 用法: dp_frog_kjump K [FILE]
+// 从 FILE（省略时为标准输入）读入以空白分隔的高度，输出 K 步青蛙跳的最小代价
+int main(int argc, char* argv[]) {
+    size_t k = 0;
+    const char* arg = argc > 1 ? argv[1] : "";
+    const auto [ptr, ec] = from_chars(arg, arg + strlen(arg), k);
+    if (argc < 2 || argc > 3 || ec != errc() || *ptr != '\0' || k == 0) {
+        cerr << "usage: " << argv[0] << " K [FILE]" << endl;
+        return 1;
+    }
+
+    FILE* file = argc == 3 ? fopen(argv[2], "rb") : stdin;
+    if (file == nullptr) {
+        cerr << "cannot open " << argv[2] << endl;
+        return 1;
+    }
+
+    const auto result = frog::minCostFromFile(file, k);
+    if (file != stdin) {
+        fclose(file);
+    }
+    if (!result) {
+        cerr << "invalid input" << endl;
+        return 1;
+    }
+
+    cout << result->cost << endl;
+
+    return 0;
+}
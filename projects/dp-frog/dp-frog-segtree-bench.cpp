@@ -0,0 +1,92 @@
+#include "frog-kjump.hpp"
+#include "frog-segtree.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace std;
+
+// 随机交替修改高度和查询区间，比较线段树和每次重新 DP 的耗时
+// 用法: dp_frog_segtree_bench [N] [操作数]（默认 10^6 和 10^4）
+template<typename F> double seconds(F&& f) {
+    const auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+struct Op {
+    bool update;
+    size_t a;  // 修改的位置，或查询的左端点
+    size_t b;  // 查询的右端点
+    int64_t height;
+};
+
+int main(int argc, char* argv[]) {
+    const size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const size_t op_count = argc > 2 ? strtoull(argv[2], nullptr, 10) : 10'000;
+    if (n == 0) {
+        return 1;
+    }
+
+    mt19937_64 rng(1);
+    uniform_int_distribution<int64_t> dist(0, 1'000'000);
+    uniform_int_distribution<size_t> pos(0, n - 1);
+    vector<int64_t> initial(n);
+    for (auto& x : initial) {
+        x = dist(rng);
+    }
+    vector<Op> ops(op_count);
+    for (size_t i = 0; i < op_count; ++i) {
+        size_t a = pos(rng);
+        size_t b = pos(rng);
+        if (a > b) {
+            swap(a, b);
+        }
+        ops[i] = {i % 2 == 0, a, b, dist(rng)};
+    }
+
+    printf("N = %zu, %zu operations (half updates, half queries)\n", n, op_count);
+    printf("%3s %10s %14s %14s %10s\n", "K", "build (ms)", "tree (us/op)", "redo (us/op)", "speedup");
+    for (const size_t k : {1, 2, 4, 8}) {
+        int64_t tree_sum = 0;
+        int64_t redo_sum = 0;
+        optional<frog::JumpTree> tree;
+
+        const double build = seconds([&] { tree.emplace(initial, k); });
+        const double tree_time = seconds([&] {
+            for (const Op& op : ops) {
+                if (op.update) {
+                    tree->update(op.a, op.height);
+                } else {
+                    tree_sum += tree->query(op.a, op.b);
+                }
+            }
+        });
+        tree.reset();
+
+        vector<int64_t> h = initial;
+        const double redo_time = seconds([&] {
+            for (const Op& op : ops) {
+                if (op.update) {
+                    h[op.a] = op.height;
+                } else {
+                    redo_sum += frog::minCost(span(h).subspan(op.a, op.b - op.a + 1), k);
+                }
+            }
+        });
+
+        if (tree_sum != redo_sum) {
+            fprintf(stderr, "mismatch: K=%zu %lld != %lld\n", k, static_cast<long long>(tree_sum),
+                    static_cast<long long>(redo_sum));
+            return 1;
+        }
+        printf("%3zu %10.1f %14.2f %14.2f %9.1fx\n", k, build * 1e3, tree_time * 1e6 / static_cast<double>(op_count),
+               redo_time * 1e6 / static_cast<double>(op_count), redo_time / tree_time);
+    }
+
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include "frog-kjump.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define FROG_HAVE_AVX2 1
+#endif
+
+namespace frog {
+
+namespace {
+
+constexpr int64_t INF = std::numeric_limits<int64_t>::max();
+
+// 每次从文件读入的字节数
+constexpr size_t READ_SIZE = 1 << 20;
+
+// 一个数最多的字符数（含符号）
+constexpr size_t MAX_TOKEN = 64;
+
+// 使用 SIMD 版本的最小 K（实测 K = 8 时 AVX2 版本仍比标量慢）
+constexpr size_t SIMD_MIN_K = 16;
+
+template<typename T> void chmin(T& a, T b) {
+    if (a > b) {
+        a = b;
+    }
+}
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+int64_t relaxScalar(const int64_t* h, const int64_t* dp, size_t n, int64_t height) {
+    int64_t best = INF;
+    for (size_t j = 0; j < n; ++j) {
+        chmin(best, dp[j] + std::abs(height - h[j]));
+    }
+    return best;
+}
+
+#ifdef FROG_HAVE_AVX2
+// AVX2 没有 64 位的 abs 和 min，用比较加混合代替；四组累加器交替使用以隐藏比较的延迟
+__attribute__((target("avx2")))
+__m256i relaxStep(__m256i best, const int64_t* h, const int64_t* dp, __m256i x) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i diff = _mm256_sub_epi64(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h)));
+    const __m256i dist = _mm256_blendv_epi8(diff, _mm256_sub_epi64(zero, diff), _mm256_cmpgt_epi64(zero, diff));
+    const __m256i cand = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(dp)), dist);
+    return _mm256_blendv_epi8(best, cand, _mm256_cmpgt_epi64(best, cand));
+}
+
+__attribute__((target("avx2")))
+int64_t relaxAvx2(const int64_t* h, const int64_t* dp, size_t n, int64_t height) {
+    const __m256i x = _mm256_set1_epi64x(height);
+    __m256i acc[4];
+    for (auto& v : acc) {
+        v = _mm256_set1_epi64x(INF);
+    }
+
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        for (size_t a = 0; a < 4; ++a) {
+            acc[a] = relaxStep(acc[a], h + j + 4 * a, dp + j + 4 * a, x);
+        }
+    }
+    for (; j + 4 <= n; j += 4) {
+        acc[0] = relaxStep(acc[0], h + j, dp + j, x);
+    }
+    for (size_t a = 1; a < 4; ++a) {
+        acc[0] = _mm256_blendv_epi8(acc[0], acc[a], _mm256_cmpgt_epi64(acc[0], acc[a]));
+    }
+
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc[0]);
+    int64_t best = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+    for (; j < n; ++j) {
+        chmin(best, dp[j] + std::abs(height - h[j]));
+    }
+    return best;
+}
+#endif
+
+} // namespace
+
+KJump::KJump(size_t k, bool simd) : k(k), heights(2 * k), costs(2 * k), relax(relaxScalar) {
+    if (k == 0) {
+        throw std::invalid_argument("k must be positive");
+    }
+#ifdef FROG_HAVE_AVX2
+    // 窗口太小时向量的归约和尾部处理抵消了收益
+    if (simd && k >= SIMD_MIN_K && __builtin_cpu_supports("avx2")) {
+        relax = relaxAvx2;
+    }
+#else
+    (void)simd;
+#endif
+}
+
+int64_t KJump::push(int64_t height) {
+    int64_t best = 0;
+    if (count > 0) {
+        // 最近 n 块石头连续存放在 [next + K - n, next + K)；
+        // 刚写入的最后一块单独处理，避免向量读取等待尚未完成的写入
+        const size_t n = std::min(count, k);
+        const size_t first = next + k - n;
+        best = relax(heights.data() + first, costs.data() + first, n - 1, height);
+        chmin(best, last_cost + std::abs(height - last_height));
+    }
+
+    heights[next] = heights[next + k] = height;
+    costs[next] = costs[next + k] = best;
+    last_height = height;
+    last_cost = best;
+    ++count;
+    if (++next == k) {
+        next = 0;
+    }
+    return best;
+}
+
+int64_t minCost(std::span<const int64_t> h, size_t k) {
+    KJump solver(k);
+    for (const int64_t height : h) {
+        solver.push(height);
+    }
+    return solver.cost();
+}
+
+std::optional<StreamResult> minCostFromFile(std::FILE* file, size_t k) {
+    KJump solver(k);
+    std::vector<char> buffer(READ_SIZE + MAX_TOKEN);
+    size_t carry = 0;  // 上一块末尾被截断的数
+
+    while (true) {
+        const size_t got = std::fread(buffer.data() + carry, 1, READ_SIZE, file);
+        if (std::ferror(file)) {
+            return std::nullopt;
+        }
+        const bool eof = got < READ_SIZE;
+        const char* p = buffer.data();
+        const char* end = p + carry + got;
+
+        // 最后一个数可能被截断，留到下一块（文件结束时除外）
+        const char* limit = end;
+        if (!eof) {
+            while (limit > p && !isBlank(limit[-1])) {
+                --limit;
+            }
+        }
+
+        while (true) {
+            while (p < limit && isBlank(*p)) {
+                ++p;
+            }
+            if (p == limit) {
+                break;
+            }
+            int64_t height = 0;
+            const auto [ptr, ec] = std::from_chars(p, limit, height);
+            if (ec != std::errc() || (ptr != limit && !isBlank(*ptr))) {
+                return std::nullopt;
+            }
+            solver.push(height);
+            p = ptr;
+        }
+
+        carry = static_cast<size_t>(end - limit);
+        if (carry > MAX_TOKEN) {
+            return std::nullopt;
+        }
+        std::memmove(buffer.data(), limit, carry);
+        if (eof) {
+            break;
+        }
+    }
+
+    return StreamResult{solver.cost(), solver.size()};
+}
+
+} // namespace frog
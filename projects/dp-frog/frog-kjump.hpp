@@ -0,0 +1,65 @@
+#ifndef FROG_KJUMP_HPP
+#define FROG_KJUMP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace frog {
+
+/**
+ * KJump - K 步青蛙跳的流式 DP
+ *
+ * 第 i 块石头的最小代价 dp[i] = min(dp[i-j] + |h[i] - h[i-j]|)，1 <= j <= min(i, K)，dp[0] = 0。
+ * 只保留最近 K 块石头的高度和代价：两份相同的环形缓冲区首尾相接，
+ * 最近 K 项在内存中总是连续的，K 路 chmin 可以直接按数组做 SIMD 比较。
+ * 支持 AVX2 的 x86-64 处理器上运行时自动选用 AVX2 版本（simd 为 false 时总用标量版本）。
+ *
+ * 代价之和必须能用 int64_t 表示。
+ */
+class KJump {
+public:
+    explicit KJump(size_t k, bool simd = true);
+
+    // 加入下一块石头，返回跳到这块石头的最小代价
+    int64_t push(int64_t height);
+
+    // 已加入的石头数
+    size_t size() const { return count; }
+
+    // 最后一块石头的最小代价，还没有石头时为 0
+    int64_t cost() const { return count == 0 ? 0 : last_cost; }
+
+    size_t jumps() const { return k; }
+
+    void reset() { count = next = 0; }
+
+private:
+    size_t k;
+    size_t count = 0;
+    size_t next = 0;               // 下一块石头的位置，即 count % K
+    int64_t last_height = 0;       // 最后一块石头
+    int64_t last_cost = 0;
+    std::vector<int64_t> heights;  // 2K 项，第 t 块石头存放在 t % K 和 t % K + K
+    std::vector<int64_t> costs;
+    int64_t (*relax)(const int64_t* h, const int64_t* dp, size_t n, int64_t height);
+};
+
+// 一次性求解，h 为空时返回 0
+int64_t minCost(std::span<const int64_t> h, size_t k);
+
+struct StreamResult {
+    int64_t cost;
+    size_t count;  // 读入的高度个数
+};
+
+// 从文件流式读取以空白分隔的十进制高度并求解，内存占用只与 K 有关；
+// 出现无法解析的内容或读取失败时返回 nullopt
+std::optional<StreamResult> minCostFromFile(std::FILE* file, size_t k);
+
+} // namespace frog
+
+#endif // FROG_KJUMP_HPP
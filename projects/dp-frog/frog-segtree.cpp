@@ -0,0 +1,139 @@
+#include "frog-segtree.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace frog {
+
+namespace {
+
+// 两个 INF 相加也不会溢出
+constexpr int64_t INF = std::numeric_limits<int64_t>::max() / 4;
+
+template<typename T> void chmin(T& a, T b) {
+    if (a > b) {
+        a = b;
+    }
+}
+
+// (min, +) 单位矩阵
+void identity(int64_t* m, size_t k) {
+    std::fill(m, m + k * k, INF);
+    for (size_t i = 0; i < k; ++i) {
+        m[i * k + i] = 0;
+    }
+}
+
+} // namespace
+
+JumpTree::JumpTree(std::span<const int64_t> heights, size_t k) : k(k), leaves(1), h(heights.begin(), heights.end()) {
+    if (k == 0) {
+        throw std::invalid_argument("k must be positive");
+    }
+    while (leaves < h.size()) {
+        leaves *= 2;
+    }
+    nodes.resize(2 * leaves * k * k);
+
+    for (size_t i = 0; i < leaves; ++i) {
+        buildLeaf(i);
+    }
+    for (size_t node = leaves - 1; node >= 1; --node) {
+        pull(node);
+    }
+}
+
+void JumpTree::buildLeaf(size_t i) {
+    int64_t* m = matrix(leaves + i);
+    identity(m, k);
+    if (i == 0 || i >= h.size()) {
+        return;  // 第 0 块石头是起点，补齐的叶子不改变状态
+    }
+
+    // 第 0 行：从 i-1-j 跳过来；其余各行把状态向后移一位
+    for (size_t j = 0; j < k; ++j) {
+        m[j] = j < i ? std::abs(h[i] - h[i - 1 - j]) : INF;
+    }
+    for (size_t r = 1; r < k; ++r) {
+        m[r * k + r] = INF;
+        m[r * k + r - 1] = 0;
+    }
+}
+
+void JumpTree::pull(size_t node) {
+    // 先经过左子区间，再经过右子区间：C = R ⊗ L
+    const int64_t* left = matrix(2 * node);
+    const int64_t* right = matrix(2 * node + 1);
+    int64_t* c = matrix(node);
+
+    std::fill(c, c + k * k, INF);
+    for (size_t i = 0; i < k; ++i) {
+        for (size_t m = 0; m < k; ++m) {
+            const int64_t a = right[i * k + m];
+            if (a >= INF) {
+                continue;
+            }
+            for (size_t j = 0; j < k; ++j) {
+                chmin(c[i * k + j], std::min(a + left[m * k + j], INF));
+            }
+        }
+    }
+}
+
+void JumpTree::update(size_t i, int64_t height) {
+    h.at(i) = height;
+
+    // h[i] 出现在 M_i .. M_{i+K} 中
+    size_t lo = leaves + i;
+    size_t hi = leaves + std::min(i + k, h.size() - 1);
+    for (size_t leaf = lo; leaf <= hi; ++leaf) {
+        buildLeaf(leaf - leaves);
+    }
+    while (lo > 1) {
+        lo /= 2;
+        hi /= 2;
+        for (size_t node = lo; node <= hi; ++node) {
+            pull(node);
+        }
+    }
+}
+
+int64_t JumpTree::query(size_t l, size_t r) const {
+    if (l > r || r >= h.size()) {
+        throw std::out_of_range("invalid range");
+    }
+
+    std::vector<int64_t> v(k, INF);
+    std::vector<int64_t> w(k);
+    v[0] = 0;
+
+    const auto apply = [&](size_t node) {
+        const int64_t* m = matrix(node);
+        for (size_t i = 0; i < k; ++i) {
+            int64_t best = INF;
+            for (size_t j = 0; j < k; ++j) {
+                chmin(best, m[i * k + j] + v[j]);
+            }
+            w[i] = std::min(best, INF);
+        }
+        v.swap(w);
+    };
+
+    // 依次经过 M_{l+1} .. M_r：左边界的节点按顺序，右边界的节点最后倒序
+    std::vector<size_t> rights;
+    for (size_t lo = leaves + l + 1, hi = leaves + r + 1; lo < hi; lo /= 2, hi /= 2) {
+        if (lo & 1) {
+            apply(lo++);
+        }
+        if (hi & 1) {
+            rights.push_back(--hi);
+        }
+    }
+    for (auto it = rights.rbegin(); it != rights.rend(); ++it) {
+        apply(*it);
+    }
+    return v[0];
+}
+
+} // namespace frog
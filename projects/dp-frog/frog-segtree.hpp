@@ -0,0 +1,51 @@
+#ifndef FROG_SEGTREE_HPP
+#define FROG_SEGTREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace frog {
+
+/**
+ * JumpTree - 高度可修改时的 K 步青蛙跳区间查询
+ *
+ * 把最近 K 块石头的代价看成状态向量 v（v[r] 为 dp[i - r]），
+ * 跳到第 i 块石头是一次 (min, +) 矩阵乘法 v' = M_i ⊗ v：
+ *   M_i[0][j] = |h[i] - h[i-1-j]|（越过开头时为 INF），M_i[r][r-1] = 0，其余为 INF。
+ * 线段树的每个节点保存区间内所有 M_i 的乘积（K x K），于是
+ * - 修改 h[p] 只影响 M_p .. M_{p+K}，更新它们和祖先节点，O((K + log N) K^3)
+ * - 查询从 l 跳到 r 的最小代价：从 (0, INF, ...) 出发依次乘上 O(log N) 个节点，O(K^2 log N)
+ * 内存为 O(N K^2)。代价之和必须小于 INF。
+ */
+class JumpTree {
+public:
+    JumpTree(std::span<const int64_t> h, size_t k);
+
+    // 把第 i 块石头的高度改为 height
+    void update(size_t i, int64_t height);
+
+    // 只经过第 l..r 块石头，从 l 跳到 r 的最小代价（l <= r < size()）
+    int64_t query(size_t l, size_t r) const;
+
+    size_t size() const { return h.size(); }
+
+    size_t jumps() const { return k; }
+
+private:
+    size_t k;
+    size_t leaves;               // 叶子数，不小于 size() 的 2 的幂
+    std::vector<int64_t> h;
+    std::vector<int64_t> nodes;  // 2 * leaves 个 K x K 矩阵，节点 1 为根，叶子 leaves + i 为 M_i
+
+    int64_t* matrix(size_t node) { return nodes.data() + node * k * k; }
+    const int64_t* matrix(size_t node) const { return nodes.data() + node * k * k; }
+
+    void buildLeaf(size_t i);
+    void pull(size_t node);
+};
+
+} // namespace frog
+
+#endif // FROG_SEGTREE_HPP
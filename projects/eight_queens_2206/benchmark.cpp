@@ -0,0 +1,73 @@
+/**
+ * 性能基准测试：舞蹈链与回溯求解器
+ *
+ * 对同一个N分别用以下方法求出全部解的数量：
+ *   - NQueens::for_each_solution：位掩码回溯，逐个访问解
+ *   - NQueens::count_parallel(1)：位掩码回溯 + 对称剪枝，单线程
+ *   - DlxQueens::count：舞蹈链
+ *
+ * 运行方法:
+ *   ./queens_benchmark [最大N]    (11 到 NQueens::MAX_SIZE，默认 13)
+ *
+ * N 不超过 queen_table::MAX_SIZE 时 NQueens 直接读编译期解表，所以从 MAX_SIZE + 1 开始比较。
+ */
+
+#include "dlx_queens.h"
+#include "nqueens.h"
+#include "queen_table.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+
+// 第一个需要搜索的棋盘大小
+constexpr int FIRST_N = queen_table::MAX_SIZE + 1;
+
+// 计时并打印一行结果
+template <typename Solve>
+void run(const char* name, const int n, Solve&& solve)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t count = solve();
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::printf("%-28s | %3d | %12llu | %10.2f ms\n", name, n,
+                static_cast<unsigned long long>(count), elapsed.count());
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int max_n = 13;
+    if (argc >= 2)
+    {
+        const char* end = argv[1] + std::strlen(argv[1]);
+        const auto [ptr, ec] = std::from_chars(argv[1], end, max_n);
+        if (argc > 2 || ec != std::errc() || ptr != end || max_n < FIRST_N || max_n > NQueens::MAX_SIZE)
+        {
+            std::fprintf(stderr, "用法: %s [最大N，%d 到 %d]\n", argv[0], FIRST_N, NQueens::MAX_SIZE);
+            return 1;
+        }
+    }
+
+    std::printf("%-28s | %3s | %12s | %13s\n", "Solver", "N", "Solutions", "Time");
+    for (int n = FIRST_N; n <= max_n; ++n)
+    {
+        run("NQueens::for_each_solution", n,
+            [n]
+            {
+                std::uint64_t count = 0;
+                NQueens(n).for_each_solution([&](const std::vector<int>&) { ++count; });
+                return count;
+            });
+        run("NQueens::count_parallel(1)", n, [n] { return NQueens(n).count_parallel(1); });
+        run("DlxQueens::count", n, [n] { return DlxQueens(n).count(); });
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "dlx.h"
+
+#include <stdexcept>
+
+DancingLinks::DancingLinks(const int primary, const int secondary)
+    : _nodes(primary + secondary + 1), _sizes(primary + secondary + 1, 0)
+{
+    // 根节点和主列头连成一个环
+    for (int i = 0; i <= primary; ++i)
+    {
+        _nodes[i] = {i == 0 ? primary : i - 1, i == primary ? 0 : i + 1, i, i, i, -1};
+    }
+    // 次列头只和自己相连，不会被选为分支列
+    for (int i = primary + 1; i <= primary + secondary; ++i)
+    {
+        _nodes[i] = {i, i, i, i, i, -1};
+    }
+}
+
+int DancingLinks::add_row(const std::vector<int>& columns)
+{
+    const int row = _rows++;
+    const int first = static_cast<int>(_nodes.size());
+    const int column_count = static_cast<int>(_sizes.size()) - 1;
+
+    for (std::size_t k = 0; k < columns.size(); ++k)
+    {
+        if (columns[k] < 0 || columns[k] >= column_count)
+        {
+            throw std::out_of_range("列编号超出范围");
+        }
+
+        // 插入到列的底部
+        const int header = columns[k] + 1;
+        const int node = static_cast<int>(_nodes.size());
+        const int left = k == 0 ? node : node - 1;
+        _nodes.push_back({left, first, _nodes[header].up, header, header, row});
+        _nodes[_nodes[header].up].down = node;
+        _nodes[header].up = node;
+        ++_sizes[header];
+
+        // 与同一行的节点连成环
+        _nodes[left].right = node;
+        _nodes[first].left = node;
+    }
+    return row;
+}
+
+void DancingLinks::cover(const int column)
+{
+    Node& header = _nodes[column];
+    _nodes[header.right].left = header.left;
+    _nodes[header.left].right = header.right;
+
+    for (int i = header.down; i != column; i = _nodes[i].down)
+    {
+        for (int j = _nodes[i].right; j != i; j = _nodes[j].right)
+        {
+            const Node& node = _nodes[j];
+            _nodes[node.down].up = node.up;
+            _nodes[node.up].down = node.down;
+            --_sizes[node.column];
+        }
+    }
+}
+
+void DancingLinks::uncover(const int column)
+{
+    Node& header = _nodes[column];
+    for (int i = header.up; i != column; i = _nodes[i].up)
+    {
+        for (int j = _nodes[i].left; j != i; j = _nodes[j].left)
+        {
+            const Node& node = _nodes[j];
+            ++_sizes[node.column];
+            _nodes[node.down].up = j;
+            _nodes[node.up].down = j;
+        }
+    }
+
+    _nodes[header.right].left = column;
+    _nodes[header.left].right = column;
+}
+
+int DancingLinks::choose_column() const
+{
+    int best = 0;
+    int best_size = 0;
+    for (int c = _nodes[0].right; c != 0; c = _nodes[c].right)
+    {
+        if (best == 0 || _sizes[c] < best_size)
+        {
+            best = c;
+            best_size = _sizes[c];
+            if (best_size <= 1)
+            {
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+std::uint64_t DancingLinks::count()
+{
+    _solution.clear();
+    return count_from();
+}
+
+std::uint64_t DancingLinks::count_from()
+{
+    const int column = choose_column();
+    if (column == 0)
+    {
+        return 1;
+    }
+    if (_sizes[column] == 0)
+    {
+        return 0;
+    }
+
+    std::uint64_t total = 0;
+    cover(column);
+    for (int r = _nodes[column].down; r != column; r = _nodes[r].down)
+    {
+        for (int j = _nodes[r].right; j != r; j = _nodes[j].right)
+        {
+            cover(_nodes[j].column);
+        }
+
+        total += count_from();
+
+        for (int j = _nodes[r].left; j != r; j = _nodes[j].left)
+        {
+            uncover(_nodes[j].column);
+        }
+    }
+    uncover(column);
+    return total;
+}
@@ -0,0 +1,98 @@
+#ifndef EIGHT_QUEENS_DLX_H
+#define EIGHT_QUEENS_DLX_H
+
+#include <cstdint>
+#include <vector>
+
+// 舞蹈链（Dancing Links）精确覆盖求解器，即Knuth的Algorithm X
+//
+// 所有节点放在一个连续的数组里，链接用数组下标表示：
+// 节点0是根，1..列数 是列头，之后是各行的节点。
+// 主列必须恰好被覆盖一次；次列最多被覆盖一次（不挂在根的链表上，不参与选列）。
+class DancingLinks
+{
+public:
+    // 构造函数：列编号 [0, primary) 为主列，[primary, primary + secondary) 为次列
+    DancingLinks(const int primary, const int secondary);
+
+    // 添加一行，columns 为该行覆盖的列编号，返回行编号
+    int add_row(const std::vector<int>& columns);
+
+    // 统计所有精确覆盖的个数
+    [[nodiscard]] std::uint64_t count();
+
+    // 逐个访问精确覆盖，visitor接收 const std::vector<int>&（选中的行编号）
+    template <typename Visitor>
+    void search(Visitor&& visitor);
+
+private:
+    // 节点：上下左右的链接、所在列头和所在行
+    struct Node
+    {
+        int left;
+        int right;
+        int up;
+        int down;
+        int column;
+        int row;
+    };
+
+    // 覆盖/恢复一列
+    void cover(const int column);
+    void uncover(const int column);
+
+    // 选择剩余行数最少的主列，没有主列时返回0
+    [[nodiscard]] int choose_column() const;
+
+    // 递归计数
+    [[nodiscard]] std::uint64_t count_from();
+
+    template <typename Visitor>
+    void search_from(Visitor& visitor);
+
+    std::vector<Node> _nodes;
+    // 每列剩余的行数（按列头节点下标）
+    std::vector<int> _sizes;
+    // 当前选中的行
+    std::vector<int> _solution;
+    int _rows = 0;
+};
+
+template <typename Visitor>
+void DancingLinks::search(Visitor&& visitor)
+{
+    _solution.clear();
+    search_from(visitor);
+}
+
+template <typename Visitor>
+void DancingLinks::search_from(Visitor& visitor)
+{
+    const int column = choose_column();
+    if (column == 0)
+    {
+        visitor(static_cast<const std::vector<int>&>(_solution));
+        return;
+    }
+
+    cover(column);
+    for (int r = _nodes[column].down; r != column; r = _nodes[r].down)
+    {
+        _solution.push_back(_nodes[r].row);
+        for (int j = _nodes[r].right; j != r; j = _nodes[j].right)
+        {
+            cover(_nodes[j].column);
+        }
+
+        search_from(visitor);
+
+        for (int j = _nodes[r].left; j != r; j = _nodes[j].left)
+        {
+            uncover(_nodes[j].column);
+        }
+        _solution.pop_back();
+    }
+    uncover(column);
+}
+
+#endif // EIGHT_QUEENS_DLX_H
@@ -0,0 +1,29 @@
+#include "dlx_queens.h"
+
+DlxQueens::DlxQueens(const int n) : _n(n), _links(2 * n, 2 * (2 * n - 1))
+{
+    // 列编号：[0, n) 行，[n, 2n) 列，之后是 row - col 和 row + col 两组对角线
+    const int diag1 = 2 * n;
+    const int diag2 = diag1 + 2 * n - 1;
+
+    // 按从中间到两边的顺序加入行和列，能让搜索更早遇到约束强的选择
+    std::vector<int> order;
+    for (int k = 0; k < n; ++k)
+    {
+        order.push_back(k % 2 == 0 ? (n - 1) / 2 - k / 2 : (n - 1) / 2 + (k + 1) / 2);
+    }
+
+    for (const int row : order)
+    {
+        for (const int col : order)
+        {
+            _links.add_row({row, n + col, diag1 + row - col + n - 1, diag2 + row + col});
+            _cells.push_back(row * n + col);
+        }
+    }
+}
+
+std::uint64_t DlxQueens::count()
+{
+    return _links.count();
+}
@@ -0,0 +1,49 @@
+#ifndef EIGHT_QUEENS_DLX_QUEENS_H
+#define EIGHT_QUEENS_DLX_QUEENS_H
+
+#include "dlx.h"
+
+#include <cstdint>
+#include <vector>
+
+// 用舞蹈链求解N皇后
+//
+// 每个格子 (row, col) 是一行，覆盖4列：
+// - 第row行、第col列（主列，必须恰好有一个皇后）
+// - 两条对角线（次列，最多有一个皇后）
+class DlxQueens
+{
+public:
+    // 构造函数，n为棋盘大小
+    explicit DlxQueens(const int n);
+
+    // 统计解的数量
+    [[nodiscard]] std::uint64_t count();
+
+    // 逐个访问解，visitor接收 const std::vector<int>&（positions[row] = col）
+    template <typename Visitor>
+    void for_each_solution(Visitor&& visitor);
+
+private:
+    int _n;
+    DancingLinks _links;
+    // 舞蹈链的行编号对应的格子 row * n + col
+    std::vector<int> _cells;
+};
+
+template <typename Visitor>
+void DlxQueens::for_each_solution(Visitor&& visitor)
+{
+    std::vector<int> positions(_n, -1);
+    _links.search(
+        [&](const std::vector<int>& rows)
+        {
+            for (const int r : rows)
+            {
+                positions[_cells[r] / _n] = _cells[r] % _n;
+            }
+            visitor(static_cast<const std::vector<int>&>(positions));
+        });
+}
+
+#endif // EIGHT_QUEENS_DLX_QUEENS_H
@@ -0,0 +1,120 @@
+#ifndef EIGHT_QUEENS_GENERATOR_H
+#define EIGHT_QUEENS_GENERATOR_H
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+// 惰性生成器（C++20协程）
+//
+// 协程每次 co_yield 一个值后挂起，调用方取走该值后再恢复协程继续计算。
+// 生成器被销毁时协程帧随之释放，所以提前停止不需要额外处理。
+// 每次调用 begin() 都会从上次停下的位置继续，可以分多次遍历。
+template <typename T>
+class Generator
+{
+public:
+    struct promise_type
+    {
+        const T* current = nullptr;
+        std::exception_ptr exception;
+
+        Generator get_return_object()
+        {
+            return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T& value) noexcept
+        {
+            current = std::addressof(value);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+    // 输入迭代器，解引用得到当前值
+    class iterator
+    {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(Generator* generator) : _generator(generator) {}
+
+        const T& operator*() const { return _generator->value(); }
+        iterator& operator++()
+        {
+            _generator->next();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(std::default_sentinel_t) const { return _generator->done(); }
+
+    private:
+        Generator* _generator = nullptr;
+    };
+
+    Generator(Generator&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+    Generator& operator=(Generator&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+    ~Generator() { reset(); }
+
+    // 恢复协程直到产生下一个值，没有更多值时返回false
+    bool next()
+    {
+        if (done())
+        {
+            return false;
+        }
+        _handle.resume();
+        if (_handle.promise().exception)
+        {
+            std::rethrow_exception(std::exchange(_handle.promise().exception, nullptr));
+        }
+        return !_handle.done();
+    }
+
+    // 当前值，只能在next()返回true之后调用
+    [[nodiscard]] const T& value() const { return *_handle.promise().current; }
+
+    // 是否已经没有更多值
+    [[nodiscard]] bool done() const { return !_handle || _handle.done(); }
+
+    // 从上次停下的位置继续遍历
+    iterator begin()
+    {
+        next();
+        return iterator(this);
+    }
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    explicit Generator(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+
+    void reset()
+    {
+        if (_handle)
+        {
+            _handle.destroy();
+            _handle = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> _handle;
+};
+
+#endif // EIGHT_QUEENS_GENERATOR_H
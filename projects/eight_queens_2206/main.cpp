@@ -1,7 +1,109 @@
+#include "nqueens.h"
 #include "queen.h"
 
-int main()
+#include <charconv>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+// 把整个字符串解析为整数，解析成功返回true
+template <typename T>
+bool parse_number(const std::string_view text, T& value)
+{
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+// 解析棋盘大小，必须在1到NQueens::MAX_SIZE之间
+bool parse_size(const std::string_view text, int& n)
+{
+    return parse_number(text, n) && n >= 1 && n <= NQueens::MAX_SIZE;
+}
+
+int usage(const char* program)
 {
+    std::cerr << "用法: " << program << " [count <N> [线程数] | count-seq <N> | first <N> <K>]\n"
+              << "      N 为 1 到 " << NQueens::MAX_SIZE << " 之间的棋盘大小" << std::endl;
+    return 1;
+}
+
+// 计数模式：eight_queens_2206 count <N> [线程数]，threads为负数时顺序计数
+int count_queens(const int n, const int threads)
+{
+    const NQueens solver(n);
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t count =
+        threads < 0 ? solver.count() : solver.count_parallel(static_cast<unsigned>(threads));
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << n << "皇后问题共有 " << count << " 个解（用时 " << elapsed.count() << " 秒）"
+              << std::endl;
+    return 0;
+}
+
+// 惰性模式：eight_queens_2206 first <N> <K>，只搜索到第K个解为止
+int first_solutions(const int n, const int k)
+{
+    if (k <= 0)
+    {
+        return 0;
+    }
+
+    // 打印完第K个解立即退出循环，生成器不再恢复，不会去搜索第K+1个解
+    const NQueens solver(n);
+    int printed = 0;
+    for (const std::vector<int>& positions : solver.solutions())
+    {
+        for (const int col : positions)
+        {
+            std::cout << col << ' ';
+        }
+        std::cout << '\n';
+        if (++printed == k)
+        {
+            break;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+try
+{
+    const std::string mode = argc >= 2 ? argv[1] : "";
+    if (mode == "count")
+    {
+        int n = 0;
+        int threads = 0;
+        if (argc < 3 || argc > 4 || !parse_size(argv[2], n)
+            || (argc == 4 && (!parse_number(argv[3], threads) || threads < 0)))
+        {
+            return usage(argv[0]);
+        }
+        return count_queens(n, threads);
+    }
+    if (mode == "first")
+    {
+        int n = 0;
+        int k = 0;
+        if (argc != 4 || !parse_size(argv[2], n) || !parse_number(argv[3], k) || k < 0)
+        {
+            return usage(argv[0]);
+        }
+        return first_solutions(n, k);
+    }
+    if (mode == "count-seq")
+    {
+        int n = 0;
+        if (argc != 3 || !parse_size(argv[2], n))
+        {
+            return usage(argv[0]);
+        }
+        return count_queens(n, -1);
+    }
+
     Queen queen;
     std::cout << "正在求解8皇后问题..." << std::endl << std::endl;
     int count = queen.solve();
@@ -20,4 +122,9 @@ int main()
     // queen.print_all_solutions();
 
     return 0;
+}
+catch (const std::exception& e)
+{
+    std::cerr << "错误: " << e.what() << std::endl;
+    return 1;
 }
\ No newline at end of file
@@ -0,0 +1,414 @@
+#include "nqueens.h"
+
+#include "queen_table.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+NQueens::NQueens(const int n)
+    : _n(n), _mask(n >= 32 ? ~std::uint32_t{0} : (std::uint32_t{1} << n) - 1)
+{
+    if (n < 1 || n > MAX_SIZE)
+    {
+        throw std::invalid_argument("棋盘大小必须在1到32之间");
+    }
+}
+
+std::uint64_t NQueens::count() const
+{
+    // 小棋盘的解数在编译期已经算好
+    if (_n <= queen_table::MAX_SIZE)
+    {
+        return queen_table::COUNTS[_n];
+    }
+
+    // 左右镜像的解一一对应：第一行只需在左半边放置，结果乘2；
+    // n为奇数时第一行放在中间列的解单独计算
+    std::uint64_t total = 0;
+    for (int col = 0; col < _n / 2; ++col)
+    {
+        const std::uint32_t bit = std::uint32_t{1} << col;
+        total += count_from(1, bit, bit << 1, bit >> 1);
+    }
+    total *= 2;
+
+    if (_n % 2 == 1)
+    {
+        const std::uint32_t bit = std::uint32_t{1} << (_n / 2);
+        total += count_from(1, bit, bit << 1, bit >> 1);
+    }
+    return total;
+}
+
+Generator<std::vector<int>> NQueens::solutions() const
+{
+    return generate(_n, _mask);
+}
+
+Generator<std::vector<int>> NQueens::generate(const int n, const std::uint32_t mask)
+{
+    // 协程不能在递归调用中挂起，所以用显式的逐行状态代替递归：
+    // available[row] 为第row行剩余可尝试的列，cols/diag1/diag2[row] 为进入该行时的占用
+    std::vector<int> positions(n, -1);
+
+    // 小棋盘的解在编译期已经算好，按顺序交出即可
+    if (n <= queen_table::MAX_SIZE)
+    {
+        const queen_table::Rows& rows = queen_table::ROWS[n];
+        for (std::size_t i = 0; i < rows.count; ++i)
+        {
+            const std::span<const std::uint8_t> row = rows.row(i);
+            std::copy(row.begin(), row.end(), positions.begin());
+            co_yield positions;
+        }
+        co_return;
+    }
+
+    std::vector<std::uint32_t> available(n, 0);
+    std::vector<std::uint32_t> cols(n, 0);
+    std::vector<std::uint32_t> diag1(n, 0);
+    std::vector<std::uint32_t> diag2(n, 0);
+
+    int row = 0;
+    available[0] = mask;
+    while (row >= 0)
+    {
+        if (available[row] == 0)
+        {
+            // 本行已无可尝试的列，回溯
+            positions[row] = -1;
+            --row;
+            continue;
+        }
+
+        const std::uint32_t bit = available[row] & -available[row];
+        available[row] ^= bit;
+        positions[row] = std::countr_zero(bit);
+
+        if (row == n - 1)
+        {
+            co_yield positions;
+            continue;
+        }
+
+        cols[row + 1] = cols[row] | bit;
+        diag1[row + 1] = (diag1[row] | bit) << 1;
+        diag2[row + 1] = (diag2[row] | bit) >> 1;
+        ++row;
+        available[row] = mask & ~(cols[row] | diag1[row] | diag2[row]);
+    }
+}
+
+std::uint64_t NQueens::count_from(const int row, const std::uint32_t cols,
+                                  const std::uint32_t diag1, const std::uint32_t diag2) const
+{
+    std::uint32_t available = _mask & ~(cols | diag1 | diag2);
+    // 最后一行：每个可放置的列都是一个解
+    if (row == _n - 1)
+    {
+        return std::popcount(available);
+    }
+
+    std::uint64_t total = 0;
+    while (available != 0)
+    {
+        const std::uint32_t bit = available & -available;
+        available ^= bit;
+        total += count_from(row + 1, cols | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1);
+    }
+    return total;
+}
+
+namespace
+{
+
+// 对称剪枝搜索的状态
+//
+// 每个解在旋转和镜像下最多有8个不同的像。按第一行皇后的位置分两类：
+// - 皇后在角上（第0列）：按第二行皇后的列 bound1 枚举，这类解的8个像互不相同
+// - 皇后不在角上：第0行的列 bound1 只取左半边，并在 bound1/bound2 行限制
+//   边列的使用，使得只有字典序最小的像会被搜索到；
+//   在最后一行用 check() 判断该解在90/180/270度旋转下是否与自身重合，
+//   重合的解只有2或4个不同的像
+// 最终总数为 count2 * 2 + count4 * 4 + count8 * 8。
+struct SymmetryState
+{
+    int last = 0;
+    std::uint32_t mask = 0;
+    std::uint32_t topbit = 0;
+    std::uint32_t endbit = 0;
+    std::uint32_t sidemask = 0;
+    std::uint32_t lastmask = 0;
+    int bound1 = 0;
+    int bound2 = 0;
+    bool corner = false;
+    // board[row] 为该行皇后所在列的位
+    std::uint32_t board[NQueens::MAX_SIZE]{};
+    std::uint64_t count2 = 0;
+    std::uint64_t count4 = 0;
+    std::uint64_t count8 = 0;
+};
+
+// 子树任务：前几行已经放好的状态
+struct SymmetryTask
+{
+    SymmetryState state;
+    int row;
+    std::uint32_t left;
+    std::uint32_t down;
+    std::uint32_t right;
+};
+
+// 判断解在旋转下的对称性，只统计规范解
+void check(SymmetryState& s)
+{
+    const std::uint32_t* board = s.board;
+
+    // 旋转90度
+    if (board[s.bound2] == 1)
+    {
+        int own = 1;
+        for (std::uint32_t ptn = 2; own <= s.last; ++own, ptn <<= 1)
+        {
+            std::uint32_t bit = 1;
+            for (int you = s.last; board[you] != ptn && board[own] >= bit; --you)
+            {
+                bit <<= 1;
+            }
+            if (board[own] > bit)
+            {
+                return;
+            }
+            if (board[own] < bit)
+            {
+                break;
+            }
+        }
+        if (own > s.last)
+        {
+            ++s.count2;
+            return;
+        }
+    }
+
+    // 旋转180度
+    if (board[s.last] == s.endbit)
+    {
+        int own = 1;
+        for (int you = s.last - 1; own <= s.last; ++own, --you)
+        {
+            std::uint32_t bit = 1;
+            for (std::uint32_t ptn = s.topbit; ptn != board[you] && board[own] >= bit; ptn >>= 1)
+            {
+                bit <<= 1;
+            }
+            if (board[own] > bit)
+            {
+                return;
+            }
+            if (board[own] < bit)
+            {
+                break;
+            }
+        }
+        if (own > s.last)
+        {
+            ++s.count4;
+            return;
+        }
+    }
+
+    // 旋转270度
+    if (board[s.bound1] == s.topbit)
+    {
+        int own = 1;
+        for (std::uint32_t ptn = s.topbit >> 1; own <= s.last; ++own, ptn >>= 1)
+        {
+            std::uint32_t bit = 1;
+            for (int you = 0; board[you] != ptn && board[own] >= bit; ++you)
+            {
+                bit <<= 1;
+            }
+            if (board[own] > bit)
+            {
+                return;
+            }
+            if (board[own] < bit)
+            {
+                break;
+            }
+        }
+    }
+
+    ++s.count8;
+}
+
+// 第一行皇后在角上的回溯，row == stop 时把子树作为任务保存下来
+void backtrack_corner(SymmetryState& s, const int row, const std::uint32_t left,
+                      const std::uint32_t down, const std::uint32_t right, const int stop,
+                      std::vector<SymmetryTask>* tasks)
+{
+    if (row == stop && tasks != nullptr)
+    {
+        tasks->push_back({s, row, left, down, right});
+        return;
+    }
+
+    std::uint32_t available = s.mask & ~(left | down | right);
+    if (row == s.last)
+    {
+        if (available != 0)
+        {
+            s.board[row] = available;
+            ++s.count8;
+        }
+        return;
+    }
+
+    // bound1 之前的行不能使用第1列，否则沿对角线翻转后的像更小
+    if (row < s.bound1)
+    {
+        available &= ~std::uint32_t{2};
+    }
+    while (available != 0)
+    {
+        const std::uint32_t bit = available & -available;
+        available ^= bit;
+        s.board[row] = bit;
+        backtrack_corner(s, row + 1, (left | bit) << 1, down | bit, (right | bit) >> 1, stop,
+                         tasks);
+    }
+}
+
+// 第一行皇后不在角上的回溯
+void backtrack_side(SymmetryState& s, const int row, const std::uint32_t left,
+                    const std::uint32_t down, const std::uint32_t right, const int stop,
+                    std::vector<SymmetryTask>* tasks)
+{
+    if (row == stop && tasks != nullptr)
+    {
+        tasks->push_back({s, row, left, down, right});
+        return;
+    }
+
+    std::uint32_t available = s.mask & ~(left | down | right);
+    if (row == s.last)
+    {
+        if (available != 0 && (available & s.lastmask) == 0)
+        {
+            s.board[row] = available;
+            check(s);
+        }
+        return;
+    }
+
+    if (row < s.bound1)
+    {
+        // bound1 之前的行不能使用两条边列
+        available &= ~s.sidemask;
+    }
+    else if (row == s.bound2)
+    {
+        // bound2 行之前必须已经用过边列
+        if ((down & s.sidemask) == 0)
+        {
+            return;
+        }
+        if ((down & s.sidemask) != s.sidemask)
+        {
+            available &= s.sidemask;
+        }
+    }
+    while (available != 0)
+    {
+        const std::uint32_t bit = available & -available;
+        available ^= bit;
+        s.board[row] = bit;
+        backtrack_side(s, row + 1, (left | bit) << 1, down | bit, (right | bit) >> 1, stop,
+                       tasks);
+    }
+}
+
+} // namespace
+
+std::uint64_t NQueens::count_parallel(unsigned threads) const
+{
+    // 任务在第3行拆分，棋盘太小时直接顺序计数
+    constexpr int SPLIT_ROW = 3;
+    if (_n < SPLIT_ROW + 3)
+    {
+        return count();
+    }
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<SymmetryTask> tasks;
+    SymmetryState s;
+    s.last = _n - 1;
+    s.mask = _mask;
+    s.topbit = std::uint32_t{1} << s.last;
+
+    // 第一行皇后在角上
+    s.corner = true;
+    s.board[0] = 1;
+    for (s.bound1 = 2; s.bound1 < s.last; ++s.bound1)
+    {
+        const std::uint32_t bit = std::uint32_t{1} << s.bound1;
+        s.board[1] = bit;
+        backtrack_corner(s, 2, (2 | bit) << 1, 1 | bit, bit >> 1, SPLIT_ROW, &tasks);
+    }
+
+    // 第一行皇后不在角上
+    s.corner = false;
+    s.sidemask = s.lastmask = s.topbit | 1;
+    s.endbit = s.topbit >> 1;
+    for (s.bound1 = 1, s.bound2 = _n - 2; s.bound1 < s.bound2; ++s.bound1, --s.bound2)
+    {
+        const std::uint32_t bit = std::uint32_t{1} << s.bound1;
+        s.board[0] = bit;
+        backtrack_side(s, 1, bit << 1, bit, bit >> 1, SPLIT_ROW, &tasks);
+        s.lastmask |= s.lastmask >> 1 | s.lastmask << 1;
+        s.endbit >>= 1;
+    }
+
+    // 每个线程从共享队列中领取任务，各自累计
+    std::vector<std::uint64_t> partial(threads, 0);
+    std::atomic<std::size_t> next_task{0};
+    auto worker = [&](const unsigned id)
+    {
+        for (std::size_t i = next_task.fetch_add(1); i < tasks.size();
+             i = next_task.fetch_add(1))
+        {
+            SymmetryTask& task = tasks[i];
+            SymmetryState& state = task.state;
+            if (state.corner)
+            {
+                backtrack_corner(state, task.row, task.left, task.down, task.right, -1, nullptr);
+            }
+            else
+            {
+                backtrack_side(state, task.row, task.left, task.down, task.right, -1, nullptr);
+            }
+            partial[id] += state.count2 * 2 + state.count4 * 4 + state.count8 * 8;
+        }
+    };
+
+    std::vector<std::jthread> pool;
+    for (unsigned id = 1; id < threads; ++id)
+    {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    pool.clear();
+
+    std::uint64_t total = 0;
+    for (const std::uint64_t c : partial)
+    {
+        total += c;
+    }
+    return total;
+}
@@ -0,0 +1,110 @@
+#ifndef EIGHT_QUEENS_NQUEENS_H
+#define EIGHT_QUEENS_NQUEENS_H
+
+#include "generator.h"
+#include "queen_table.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// 任意N皇后求解器
+//
+// 与Queen使用相同的逐行回溯，但列和两条对角线的占用都保存在机器字里：
+// 每一行可放置的位置是 ~(cols | diag1 | diag2) 中的置位，
+// 用 bits & -bits 逐个取出最低位，下一行的对角线只需左移/右移一位。
+class NQueens
+{
+public:
+    // 构造函数，n为棋盘大小（1到MAX_SIZE）
+    explicit NQueens(const int n);
+
+    // 只计数，不保存任何解
+    [[nodiscard]] std::uint64_t count() const;
+
+    // 多线程计数：利用旋转和镜像对称只搜索规范子树，
+    // threads为0时使用全部硬件线程，结果与count()完全相同
+    [[nodiscard]] std::uint64_t count_parallel(unsigned threads = 0) const;
+
+    // 按字典序逐个访问解，visitor接收 const std::vector<int>&（positions[row] = col）；
+    // n不超过queen_table::MAX_SIZE时直接读编译期解表，不做搜索
+    template <typename Visitor>
+    void for_each_solution(Visitor&& visitor) const;
+
+    // 惰性生成解：每找到一个解就交出，调用方取走后才继续搜索，
+    // 内存占用只与n有关；可以随时停止，或稍后从停下的位置继续；小棋盘同样读解表
+    [[nodiscard]] Generator<std::vector<int>> solutions() const;
+
+    // 获取棋盘大小
+    [[nodiscard]] int size() const { return _n; }
+
+    static constexpr int MAX_SIZE = 32;
+
+private:
+    // 生成解的协程，参数按值保存在协程帧中，不依赖NQueens对象的生命周期
+    static Generator<std::vector<int>> generate(const int n, const std::uint32_t mask);
+
+    // 从第row行开始计数
+    [[nodiscard]] std::uint64_t count_from(const int row, const std::uint32_t cols,
+                                           const std::uint32_t diag1,
+                                           const std::uint32_t diag2) const;
+
+    // 从第row行开始逐个访问解
+    template <typename Visitor>
+    void visit_from(const int row, const std::uint32_t cols, const std::uint32_t diag1,
+                    const std::uint32_t diag2, std::vector<int>& positions,
+                    Visitor& visitor) const;
+
+    // 棋盘大小
+    int _n;
+    // 低n位全为1
+    std::uint32_t _mask;
+};
+
+template <typename Visitor>
+void NQueens::for_each_solution(Visitor&& visitor) const
+{
+    std::vector<int> positions(_n, -1);
+    if (_n <= queen_table::MAX_SIZE)
+    {
+        const queen_table::Rows& rows = queen_table::ROWS[_n];
+        for (std::size_t i = 0; i < rows.count; ++i)
+        {
+            const std::span<const std::uint8_t> row = rows.row(i);
+            std::copy(row.begin(), row.end(), positions.begin());
+            visitor(static_cast<const std::vector<int>&>(positions));
+        }
+        return;
+    }
+    visit_from(0, 0, 0, 0, positions, visitor);
+}
+
+template <typename Visitor>
+void NQueens::visit_from(const int row, const std::uint32_t cols, const std::uint32_t diag1,
+                         const std::uint32_t diag2, std::vector<int>& positions,
+                         Visitor& visitor) const
+{
+    if (row == _n)
+    {
+        visitor(static_cast<const std::vector<int>&>(positions));
+        return;
+    }
+
+    // 第row行所有可放置的列
+    std::uint32_t available = _mask & ~(cols | diag1 | diag2);
+    while (available != 0)
+    {
+        const std::uint32_t bit = available & -available;
+        available ^= bit;
+
+        positions[row] = std::countr_zero(bit);
+        visit_from(row + 1, cols | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, positions,
+                   visitor);
+    }
+    positions[row] = -1;
+}
+
+#endif // EIGHT_QUEENS_NQUEENS_H
@@ -1,5 +1,7 @@
 #include "queen.h"
 
+#include "queen_table.h"
+
 Queen::Queen()
     : _positions(BOARD_SIZE, -1), _cols(BOARD_SIZE, false), _diag1(2 * BOARD_SIZE - 1, false),
       _diag2(2 * BOARD_SIZE - 1, false)
@@ -9,7 +11,20 @@ Queen::Queen()
 int Queen::solve()
 {
     _solutions.clear();
-    backtrack(0);
+    if constexpr (BOARD_SIZE <= queen_table::MAX_SIZE)
+    {
+        // 小棋盘直接使用编译期生成的解表，运行时不做任何搜索
+        const auto& table = queen_table::SOLUTIONS<BOARD_SIZE>;
+        _solutions.reserve(table.size());
+        for (const auto& solution : table)
+        {
+            _solutions.emplace_back(solution.begin(), solution.end());
+        }
+    }
+    else
+    {
+        backtrack(0);
+    }
     return static_cast<int>(_solutions.size());
 }
 
@@ -0,0 +1,124 @@
+#ifndef EIGHT_QUEENS_QUEEN_TABLE_H
+#define EIGHT_QUEENS_QUEEN_TABLE_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+// 编译期N皇后解表
+//
+// 对 N <= MAX_SIZE，解的个数和所有解都在编译期用与NQueens相同的位掩码回溯算出，
+// 作为常量表放进程序里，运行时不需要任何搜索。
+namespace queen_table
+{
+
+// 编译期求解的最大棋盘
+constexpr int MAX_SIZE = 10;
+
+// 从第row行开始计数
+constexpr std::size_t count_from(const int n, const int row, const std::uint32_t cols,
+                                 const std::uint32_t diag1, const std::uint32_t diag2)
+{
+    if (row == n)
+    {
+        return 1;
+    }
+
+    std::size_t total = 0;
+    std::uint32_t available = ((std::uint32_t{1} << n) - 1) & ~(cols | diag1 | diag2);
+    while (available != 0)
+    {
+        const std::uint32_t bit = available & -available;
+        available ^= bit;
+        total += count_from(n, row + 1, cols | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1);
+    }
+    return total;
+}
+
+// N皇后解的个数
+constexpr std::size_t count(const int n)
+{
+    return count_from(n, 0, 0, 0, 0);
+}
+
+// 解表：solutions[i][row] = col，按字典序排列（与Queen::solve的顺序相同）
+template <int N>
+using Table = std::array<std::array<std::uint8_t, N>, count(N)>;
+
+// 从第row行开始把解写入表中
+template <int N>
+constexpr void fill_from(Table<N>& table, std::size_t& size, std::array<std::uint8_t, N>& positions,
+                         const int row, const std::uint32_t cols, const std::uint32_t diag1,
+                         const std::uint32_t diag2)
+{
+    if (row == N)
+    {
+        table[size++] = positions;
+        return;
+    }
+
+    std::uint32_t available = ((std::uint32_t{1} << N) - 1) & ~(cols | diag1 | diag2);
+    while (available != 0)
+    {
+        const std::uint32_t bit = available & -available;
+        available ^= bit;
+        positions[row] = static_cast<std::uint8_t>(std::countr_zero(bit));
+        fill_from<N>(table, size, positions, row + 1, cols | bit, (diag1 | bit) << 1,
+                     (diag2 | bit) >> 1);
+    }
+}
+
+// 生成解表
+template <int N>
+constexpr Table<N> make_table()
+{
+    static_assert(N >= 1 && N <= MAX_SIZE, "编译期解表只支持 1 <= N <= MAX_SIZE");
+
+    Table<N> table{};
+    std::array<std::uint8_t, N> positions{};
+    std::size_t size = 0;
+    fill_from<N>(table, size, positions, 0, 0, 0, 0);
+    return table;
+}
+
+// N皇后的全部解
+template <int N>
+inline constexpr Table<N> SOLUTIONS = make_table<N>();
+
+// 不依赖N的解表访问方式：row(i) 为第i个解，count 为解的个数
+struct Rows
+{
+    std::size_t count;
+    std::span<const std::uint8_t> (*row)(std::size_t);
+};
+
+template <int N>
+constexpr std::span<const std::uint8_t> row_of(const std::size_t i)
+{
+    return SOLUTIONS<N>[i];
+}
+
+template <int... Ns>
+constexpr std::array<Rows, MAX_SIZE + 1> make_rows(std::integer_sequence<int, Ns...>)
+{
+    return {Rows{0, nullptr}, Rows{SOLUTIONS<Ns + 1>.size(), &row_of<Ns + 1>}...};
+}
+
+// 各棋盘大小的全部解：ROWS[n]，1 <= n <= MAX_SIZE
+inline constexpr std::array<Rows, MAX_SIZE + 1> ROWS = make_rows(std::make_integer_sequence<int, MAX_SIZE>{});
+
+// 各棋盘大小的解的个数：COUNTS[n]
+inline constexpr std::array<std::size_t, MAX_SIZE + 1> COUNTS = {
+    0,        count(1), count(2), count(3), count(4), count(5),
+    count(6), count(7), count(8), count(9), count(10)};
+
+static_assert(COUNTS[8] == 92, "8皇后应有92个解");
+static_assert(SOLUTIONS<4>[0][0] == 1 && SOLUTIONS<4>[1][0] == 2, "4皇后的两个解");
+static_assert(ROWS[8].count == 92 && ROWS[8].row(0)[1] == 4, "8皇后的解表");
+
+} // namespace queen_table
+
+#endif // EIGHT_QUEENS_QUEEN_TABLE_H
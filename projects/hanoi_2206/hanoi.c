@@ -18,45 +18,156 @@ A柱上有n个不同大小的圆盘，从上到下按从小到大排列
 将最大的圆盘从A移到C
 将(n-1)个圆盘从B移到C（借助A）
 
+展开这个递归可以发现，第k步移动的圆盘和柱子只由k的二进制表示决定，
+不需要递归，也不需要记住之前的步骤（见 hanoi_moves.h）。
+于是可以按序号直接生成每一步，写入大缓冲区后用 write 一次输出一大块，
+也可以直接求出第k步之后各圆盘所在的位置。
+每条记录的长度固定，序号区间可以分给多个线程同时生成，
+输出到文件时每块直接写到按序号算出的偏移处。
+
+四根及以上的柱子用 Frame–Stewart 算法（见 hanoi_multipeg.h），
+最少步数由备忘表查出，步骤由迭代器逐步生成。
+
 */
+#define _XOPEN_SOURCE 700  // sysconf 等 POSIX 接口
+
+#include "hanoi_moves.h"
+#include "hanoi_multipeg.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 解析圆盘数，超出 1 到 max 的范围返回0
+static int parse_disks(const char *text, int max) {
+    char *end;
+    const long n = strtol(text, &end, 10);
+    return *end == '\0' && n >= 1 && n <= max ? (int)n : 0;
+}
 
-// 递归函数：移动n个圆盘从source到target，使用auxiliary作为辅助柱
-void hanoi(int n, char source, char auxiliary, char target) {
-    if (n == 1) {
-        // 基本情况：只有一个圆盘，直接移动
-        printf("将圆盘 1 从 %c 移动到 %c\n", source, target);
-        return;
+// 打印第k步之后三根柱子上的圆盘（从下到上）
+static void print_state(int n, unsigned long long k) {
+    unsigned char peg_of_disk[HANOI_MAX_DISKS + 1];
+    hanoi_state_after(n, k, peg_of_disk);
+
+    printf("第 %llu 步之后:\n", k);
+    for (int peg = 0; peg < 3; ++peg) {
+        printf("%c:", "ABC"[peg]);
+        for (int d = n; d >= 1; --d) {
+            if (peg_of_disk[d] == peg) {
+                printf(" %d", d);
+            }
+        }
+        printf("\n");
     }
+}
 
-    // 步骤1：将上面的(n-1)个圆盘从source移到auxiliary（借助target）
-    hanoi(n - 1, source, target, auxiliary);
+// 解析线程数，超出范围返回0
+static int parse_threads(const char *text) {
+    char *end;
+    const long threads = strtol(text, &end, 10);
+    return *end == '\0' && threads >= 1 && threads <= 1024 ? (int)threads : 0;
+}
 
-    // 步骤2：将最大的圆盘从source移到target
-    printf("将圆盘 %d 从 %c 移动到 %c\n", n, source, target);
+// p 根柱子：输出最少步数，或逐步生成并输出全部步骤
+static int run_multipeg(int n, int pegs, int count_only) {
+    if (count_only) {
+        hanoi_count count;
+        char digits[HANOI_COUNT_DIGITS + 1];
+        if (hanoi_multi_moves(n, pegs, &count) != 0) {
+            fprintf(stderr, "内存不足\n");
+            return 1;
+        }
+        hanoi_count_format(count, digits);
+        printf("%d 个圆盘、%d 根柱子最少需要%s %s 步\n", n, pegs, count == HANOI_COUNT_MAX ? "不少于" : "", digits);
+        return 0;
+    }
+
+    hanoi_multi_iter it;
+    if (hanoi_multi_iter_init(&it, n, pegs) != 0) {
+        fprintf(stderr, "内存不足\n");
+        return 1;
+    }
+    hanoi_move move;
+    while (hanoi_multi_next(&it, &move)) {
+        printf("将圆盘 %2d 从 %c 移动到 %c\n", move.disk, 'A' + move.from, 'A' + move.to);
+    }
+    hanoi_multi_iter_free(&it);
+    return fflush(stdout) == 0 ? 0 : 1;
+}
 
-    // 步骤3：将(n-1)个圆盘从auxiliary移到target（借助source）
-    hanoi(n - 1, auxiliary, source, target);
+static void usage(const char *program) {
+    fprintf(stderr, "用法: %s [圆盘数 [--after 步数 | --threads 线程数]]\n"
+                    "      %s 圆盘数 --pegs 柱子数 [--count]\n", program, program);
 }
 
-int main() {
+int main(int argc, char *argv[]) {
     int n;
 
+    if (argc >= 4 && strcmp(argv[2], "--pegs") == 0) {
+        // 多柱模式：柱子从 A 开始编号，最后一根为目标柱
+        n = parse_disks(argv[1], HANOI_MULTI_MAX_DISKS);
+        const int pegs = parse_disks(argv[3], HANOI_MULTI_MAX_PEGS);
+        if (n == 0 || pegs < 3 || argc > 5 || (argc == 5 && strcmp(argv[4], "--count") != 0)) {
+            usage(argv[0]);
+            return 1;
+        }
+        return run_multipeg(n, pegs, argc == 5);
+    }
+
+    if (argc > 1) {
+        // 命令行模式：只输出移动步骤，或第k步之后的状态
+        n = parse_disks(argv[1], HANOI_MAX_DISKS);
+        if (n == 0 || (argc != 2 && argc != 4)
+            || (argc == 4 && strcmp(argv[2], "--after") != 0 && strcmp(argv[2], "--threads") != 0)) {
+            usage(argv[0]);
+            return 1;
+        }
+
+        // 默认每个在线的处理器一个线程
+        const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        int threads = cpus > 1 ? (int)cpus : 1;
+        if (argc == 4 && strcmp(argv[2], "--threads") == 0) {
+            threads = parse_threads(argv[3]);
+            if (threads == 0) {
+                fprintf(stderr, "线程数必须在 1 到 1024 之间\n");
+                return 1;
+            }
+        } else if (argc == 4) {
+            char *end;
+            const unsigned long long k = strtoull(argv[3], &end, 10);
+            if (*end != '\0' || argv[3][0] == '-' || k > hanoi_total_moves(n)) {
+                fprintf(stderr, "步数必须在 0 到 %llu 之间\n", (unsigned long long)hanoi_total_moves(n));
+                return 1;
+            }
+            print_state(n, k);
+            return 0;
+        }
+        return hanoi_write_moves_parallel(STDOUT_FILENO, n, 1, hanoi_total_moves(n), threads) == 0 ? 0 : 1;
+    }
+
     printf("请输入圆盘数量: ");
-    scanf("%d", &n);
+    if (scanf("%d", &n) != 1) {
+        n = 0;
+    }
 
     if (n <= 0) {
         printf("圆盘数量必须大于0\n");
         return 1;
     }
+    if (n > HANOI_MAX_DISKS) {
+        printf("圆盘数量不能超过%d\n", HANOI_MAX_DISKS);
+        return 1;
+    }
 
     printf("\n移动 %d 个圆盘的步骤:\n\n", n);
-    hanoi(n, 'A', 'B', 'C');
+    fflush(stdout);  // 步骤直接写到文件描述符，先输出缓冲区中的内容
+    if (hanoi_write_moves(STDOUT_FILENO, n, 1, hanoi_total_moves(n)) != 0) {
+        return 1;
+    }
 
     // 计算总步数
-    int total_moves = (1 << n) - 1;
-    printf("\n总共需要 %d 步\n", total_moves);
+    printf("\n总共需要 %llu 步\n", (unsigned long long)hanoi_total_moves(n));
 
     return 0;
 }
-
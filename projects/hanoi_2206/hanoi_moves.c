@@ -0,0 +1,291 @@
+#define _XOPEN_SOURCE 700  // pwrite、fcntl 等 POSIX 接口
+
+#include "hanoi_moves.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char PEG_NAMES[3] = {'A', 'B', 'C'};
+
+// n 为偶数时交换 1、2 号柱
+static int peg_for(int n, unsigned peg) {
+    static const int SWAPPED[3] = {0, 2, 1};
+    return (n & 1) ? (int)peg : SWAPPED[peg];
+}
+
+uint64_t hanoi_total_moves(int n) {
+    return ((uint64_t)1 << n) - 1;
+}
+
+hanoi_move hanoi_move_at(int n, uint64_t k) {
+    hanoi_move move;
+    move.disk = __builtin_ctzll(k) + 1;
+    move.from = peg_for(n, (unsigned)((k & (k - 1)) % 3));
+    move.to = peg_for(n, (unsigned)(((k | (k - 1)) + 1) % 3));
+    return move;
+}
+
+void hanoi_state_after(int n, uint64_t k, unsigned char *peg_of_disk) {
+    // 从最大的圆盘开始：前 2^(d-1) 步里圆盘 d 还在起始柱上，
+    // 之后它已在目标柱，剩下的 d-1 个圆盘从辅助柱移向目标柱
+    int source = 0, auxiliary = 1, target = 2;
+    for (int d = n; d >= 1; --d) {
+        const uint64_t half = (uint64_t)1 << (d - 1);
+        if (k < half) {
+            peg_of_disk[d] = (unsigned char)source;
+            const int t = auxiliary;
+            auxiliary = target;
+            target = t;
+        } else {
+            peg_of_disk[d] = (unsigned char)target;
+            k -= half;
+            const int s = source;
+            source = auxiliary;
+            auxiliary = s;
+        }
+    }
+}
+
+// 所有可能的记录：records[disk][from][to]
+typedef char hanoi_record[HANOI_RECORD_SIZE + 1];
+
+static void build_records(hanoi_record records[][3][3], int n) {
+    for (int disk = 1; disk <= n; ++disk) {
+        for (int from = 0; from < 3; ++from) {
+            for (int to = 0; to < 3; ++to) {
+                // "将圆盘 " 为 10 字节，"从 " 为 4 字节，"移动到 " 为 10 字节
+                char *r = records[disk][from][to];
+                memcpy(r, "将圆盘 ", 10);
+                r[10] = disk >= 10 ? (char)('0' + disk / 10) : ' ';
+                r[11] = (char)('0' + disk % 10);
+                r[12] = ' ';
+                memcpy(r + 13, "从 ", 4);
+                r[17] = PEG_NAMES[from];
+                r[18] = ' ';
+                memcpy(r + 19, "移动到 ", 10);
+                r[29] = PEG_NAMES[to];
+                r[30] = '\n';
+            }
+        }
+    }
+}
+
+// 记录表与 n 无关，第一次使用时生成所有圆盘的记录
+static hanoi_record *get_records(void) {
+    static hanoi_record records[HANOI_MAX_DISKS + 1][3][3];
+    static int built = 0;
+    if (!built) {
+        build_records(records, HANOI_MAX_DISKS);
+        built = 1;
+    }
+    return &records[0][0][0];
+}
+
+void hanoi_format_moves(int n, uint64_t first, uint64_t count, char *buf) {
+    hanoi_record *records = get_records();
+    const unsigned peg_map[3] = {0, (unsigned)peg_for(n, 1), (unsigned)peg_for(n, 2)};
+
+    for (uint64_t k = first; k < first + count; ++k) {
+        const unsigned disk = (unsigned)__builtin_ctzll(k) + 1;
+        const unsigned from = peg_map[(k & (k - 1)) % 3];
+        const unsigned to = peg_map[((k | (k - 1)) + 1) % 3];
+        memcpy(buf, records[(disk * 3 + from) * 3 + to], HANOI_RECORD_SIZE);
+        buf += HANOI_RECORD_SIZE;
+    }
+}
+
+// 写出全部数据，处理被信号中断和部分写入
+static int write_all(int fd, const char *data, size_t size) {
+    while (size > 0) {
+        const ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return 0;
+}
+
+int hanoi_write_moves(int fd, int n, uint64_t first, uint64_t count) {
+    char *buffer = malloc((size_t)HANOI_BUFFER_RECORDS * HANOI_RECORD_SIZE);
+    if (buffer == NULL) {
+        return -1;
+    }
+
+    int result = 0;
+    while (count > 0 && result == 0) {
+        const uint64_t batch = count < HANOI_BUFFER_RECORDS ? count : HANOI_BUFFER_RECORDS;
+        hanoi_format_moves(n, first, batch, buffer);
+        result = write_all(fd, buffer, (size_t)batch * HANOI_RECORD_SIZE);
+        first += batch;
+        count -= batch;
+    }
+
+    free(buffer);
+    return result;
+}
+
+// 在偏移 offset 处写出全部数据
+static int pwrite_all(int fd, const char *data, size_t size, off_t offset) {
+    while (size > 0) {
+        const ssize_t written = pwrite(fd, data, size, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        data += written;
+        size -= (size_t)written;
+        offset += written;
+    }
+    return 0;
+}
+
+typedef struct {
+    int fd;
+    int n;
+    int threads;
+    int seekable;            // fd 是普通文件，可以用 pwrite
+    off_t base;              // 第 first 步的记录在文件中的偏移
+    uint64_t first;
+    uint64_t count;
+    uint64_t chunks;
+    atomic_int failed;
+    pthread_mutex_t lock;
+    pthread_cond_t turn;
+    uint64_t next_chunk;     // 顺序输出时下一个该写出的块号
+} parallel_job;
+
+typedef struct {
+    parallel_job *job;
+    int index;
+} parallel_worker;
+
+// 顺序输出：等到轮到第 chunk 块再写，写完交给下一块
+static int write_in_order(parallel_job *job, uint64_t chunk, const char *data, size_t size) {
+    pthread_mutex_lock(&job->lock);
+    while (!atomic_load(&job->failed) && job->next_chunk != chunk) {
+        pthread_cond_wait(&job->turn, &job->lock);
+    }
+    pthread_mutex_unlock(&job->lock);
+    if (atomic_load(&job->failed)) {
+        return -1;
+    }
+
+    // 此时其他线程都在等待后面的块，可以在锁外写
+    const int result = write_all(job->fd, data, size);
+
+    pthread_mutex_lock(&job->lock);
+    if (result != 0) {
+        atomic_store(&job->failed, 1);
+    }
+    ++job->next_chunk;
+    pthread_cond_broadcast(&job->turn);
+    pthread_mutex_unlock(&job->lock);
+    return result;
+}
+
+static void *parallel_worker_main(void *arg) {
+    const parallel_worker *worker = arg;
+    parallel_job *job = worker->job;
+
+    char *buffer = malloc((size_t)HANOI_BUFFER_RECORDS * HANOI_RECORD_SIZE);
+    if (buffer == NULL) {
+        pthread_mutex_lock(&job->lock);
+        atomic_store(&job->failed, 1);
+        pthread_cond_broadcast(&job->turn);
+        pthread_mutex_unlock(&job->lock);
+        return NULL;
+    }
+
+    for (uint64_t chunk = (uint64_t)worker->index; chunk < job->chunks && !atomic_load(&job->failed);
+         chunk += (uint64_t)job->threads) {
+        const uint64_t offset = chunk * HANOI_BUFFER_RECORDS;
+        const uint64_t rest = job->count - offset;
+        const uint64_t batch = rest < HANOI_BUFFER_RECORDS ? rest : HANOI_BUFFER_RECORDS;
+        const size_t size = (size_t)batch * HANOI_RECORD_SIZE;
+
+        hanoi_format_moves(job->n, job->first + offset, batch, buffer);
+        if (job->seekable) {
+            if (pwrite_all(job->fd, buffer, size, job->base + (off_t)(offset * HANOI_RECORD_SIZE)) != 0) {
+                atomic_store(&job->failed, 1);
+            }
+        } else if (write_in_order(job, chunk, buffer, size) != 0) {
+            break;
+        }
+    }
+
+    free(buffer);
+    return NULL;
+}
+
+int hanoi_write_moves_parallel(int fd, int n, uint64_t first, uint64_t count, int threads) {
+    if (threads <= 1 || count <= HANOI_BUFFER_RECORDS) {
+        return hanoi_write_moves(fd, n, first, count);
+    }
+
+    parallel_job job;
+    struct stat info;
+    job.fd = fd;
+    job.n = n;
+    job.first = first;
+    job.count = count;
+    job.chunks = (count + HANOI_BUFFER_RECORDS - 1) / HANOI_BUFFER_RECORDS;
+    job.threads = job.chunks < (uint64_t)threads ? (int)job.chunks : threads;
+    // 以 O_APPEND 打开时 Linux 的 pwrite 忽略偏移，只能顺序输出
+    const int flags = fcntl(fd, F_GETFL);
+    job.base = lseek(fd, 0, SEEK_CUR);
+    job.seekable = job.base >= 0 && flags >= 0 && (flags & O_APPEND) == 0 && fstat(fd, &info) == 0
+                && S_ISREG(info.st_mode);
+    job.next_chunk = 0;
+    atomic_init(&job.failed, 0);
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.turn, NULL);
+
+    get_records();  // 在启动线程之前生成记录表
+
+    pthread_t *ids = malloc((size_t)job.threads * sizeof *ids);
+    parallel_worker *workers = malloc((size_t)job.threads * sizeof *workers);
+    int started = 0;
+    if (ids != NULL && workers != NULL) {
+        for (; started < job.threads; ++started) {
+            workers[started].job = &job;
+            workers[started].index = started;
+            if (pthread_create(&ids[started], NULL, parallel_worker_main, &workers[started]) != 0) {
+                break;
+            }
+        }
+    }
+    if (started < job.threads) {
+        // 没有启动的线程负责的块无法写出
+        pthread_mutex_lock(&job.lock);
+        atomic_store(&job.failed, 1);
+        pthread_cond_broadcast(&job.turn);
+        pthread_mutex_unlock(&job.lock);
+    }
+    for (int i = 0; i < started; ++i) {
+        pthread_join(ids[i], NULL);
+    }
+
+    int result = atomic_load(&job.failed) ? -1 : 0;
+    if (result == 0 && job.seekable
+        && lseek(fd, job.base + (off_t)(count * HANOI_RECORD_SIZE), SEEK_SET) < 0) {
+        result = -1;
+    }
+
+    free(workers);
+    free(ids);
+    pthread_cond_destroy(&job.turn);
+    pthread_mutex_destroy(&job.lock);
+    return result;
+}
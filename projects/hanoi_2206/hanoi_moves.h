@@ -0,0 +1,52 @@
+#ifndef HANOI_MOVES_H
+#define HANOI_MOVES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+按序号直接计算汉诺塔的第 k 步（k 从 1 开始，共 2^n - 1 步）：
+
+移动的圆盘是 k 的二进制末尾 0 的个数加 1；
+把三根柱子编号为 0、1、2，这一步从 (k & (k-1)) % 3 移到 ((k | (k-1)) + 1) % 3，
+这是 n 为奇数时从 0 号柱移到 2 号柱的解；n 为偶数时交换 1、2 号柱即可。
+0、1、2 号柱分别对应 A（起始柱）、B（辅助柱）、C（目标柱）。
+*/
+
+// 支持的最大圆盘数（总步数 2^n - 1 要能用 uint64_t 表示，且公式中的 (k | (k-1)) + 1 不能溢出）
+#define HANOI_MAX_DISKS 63
+
+// 每块的步数，也是 hanoi_write_moves 一次 write 写出的记录数
+#define HANOI_BUFFER_RECORDS (1 << 15)
+
+// 每条移动记录的字节数：形如 "将圆盘 %2d 从 %c 移动到 %c\n"，定长便于直接计算偏移
+#define HANOI_RECORD_SIZE 31
+
+typedef struct {
+    int disk;  // 圆盘编号，1 为最小
+    int from;  // 起始柱 0/1/2
+    int to;    // 目标柱 0/1/2
+} hanoi_move;
+
+// n 个圆盘的总步数
+uint64_t hanoi_total_moves(int n);
+
+// 第 k 步（1 <= k <= hanoi_total_moves(n)）
+hanoi_move hanoi_move_at(int n, uint64_t k);
+
+// 第 k 步之后（k = 0 为初始状态）每个圆盘所在的柱子：peg_of_disk[d] 为圆盘 d 的柱子，d 从 1 到 n，O(n)
+void hanoi_state_after(int n, uint64_t k, unsigned char *peg_of_disk);
+
+// 把第 first 步起的 count 步按定长记录写入 buf（至少 count * HANOI_RECORD_SIZE 字节）
+void hanoi_format_moves(int n, uint64_t first, uint64_t count, char *buf);
+
+// 把第 first 步起的 count 步写到文件描述符 fd，经由大缓冲区用 write 输出；成功返回 0，失败返回 -1
+int hanoi_write_moves(int fd, int n, uint64_t first, uint64_t count);
+
+// 用 threads 个线程并行生成第 first 步起的 count 步并写到 fd：
+// 按 HANOI_BUFFER_RECORDS 步分块，第 i 块由第 i % threads 个线程生成到自己的缓冲区；
+// fd 是普通文件时每块用 pwrite 写到由序号算出的偏移处，否则各线程按块号轮流用 write 输出。
+// 写完后 fd 的文件位置在输出末尾。成功返回 0，失败返回 -1
+int hanoi_write_moves_parallel(int fd, int n, uint64_t first, uint64_t count, int threads);
+
+#endif // HANOI_MOVES_H
@@ -0,0 +1,179 @@
+#include "hanoi_multipeg.h"
+#include <stdlib.h>
+
+// 备忘表的一行：固定柱子数，count[i]、split[i] 为 i 个圆盘的最少步数和最优的 k
+typedef struct {
+    hanoi_count *count;
+    int *split;
+    int size;  // 已算出的圆盘数 0 .. size-1
+} fs_row;
+
+static fs_row rows[HANOI_MULTI_MAX_PEGS + 1];
+
+// 饱和加法：超出范围时为 HANOI_COUNT_MAX
+static hanoi_count add_saturated(hanoi_count a, hanoi_count b) {
+    const hanoi_count sum = a + b;
+    return sum < a ? HANOI_COUNT_MAX : sum;
+}
+
+// 把 pegs 根柱子的一行扩展到至少 n 个圆盘
+static int extend_row(int pegs, int n) {
+    fs_row *row = &rows[pegs];
+    if (row->size > n) {
+        return 0;
+    }
+
+    // 容量按倍数增长，连续查询递增的 n 时摊还 O(1)
+    int capacity = row->size * 2 > n + 1 ? row->size * 2 : n + 1;
+    if (capacity > HANOI_MULTI_MAX_DISKS + 1) {
+        capacity = HANOI_MULTI_MAX_DISKS + 1;
+    }
+    if (pegs > 3 && extend_row(pegs - 1, capacity - 1) != 0) {
+        return -1;
+    }
+    hanoi_count *count = realloc(row->count, (size_t)capacity * sizeof *count);
+    if (count == NULL) {
+        return -1;
+    }
+    row->count = count;
+    int *split = realloc(row->split, (size_t)capacity * sizeof *split);
+    if (split == NULL) {
+        return -1;
+    }
+    row->split = split;
+
+    const hanoi_count *fewer = rows[pegs - 1].count;
+    for (int i = row->size; i < capacity; ++i) {
+        if (i <= 1) {
+            count[i] = (hanoi_count)i;
+            split[i] = 0;
+        } else if (pegs == 3) {
+            count[i] = add_saturated(count[i - 1], add_saturated(count[i - 1], 1));
+            split[i] = i - 1;
+        } else {
+            // 最优的 k 随圆盘数单调不减，从上一个圆盘数的 k 往后找到不再变小为止
+            int k = split[i - 1] > 1 ? split[i - 1] : 1;
+            hanoi_count best = add_saturated(add_saturated(count[k], count[k]), fewer[i - k]);
+            while (k + 1 < i) {
+                const hanoi_count next = add_saturated(add_saturated(count[k + 1], count[k + 1]), fewer[i - k - 1]);
+                if (next > best) {
+                    break;
+                }
+                best = next;
+                ++k;
+            }
+            count[i] = best;
+            split[i] = k;
+        }
+    }
+    row->size = capacity;
+    return 0;
+}
+
+static int valid(int n, int pegs) {
+    return n >= 0 && n <= HANOI_MULTI_MAX_DISKS && pegs >= 3 && pegs <= HANOI_MULTI_MAX_PEGS;
+}
+
+int hanoi_multi_moves(int n, int pegs, hanoi_count *count) {
+    if (!valid(n, pegs) || extend_row(pegs, n) != 0) {
+        return -1;
+    }
+    *count = rows[pegs].count[n];
+    return 0;
+}
+
+size_t hanoi_count_format(hanoi_count count, char *buf) {
+    char digits[HANOI_COUNT_DIGITS];
+    size_t length = 0;
+    do {
+        digits[length++] = (char)('0' + (int)(count % 10));
+        count /= 10;
+    } while (count != 0);
+
+    for (size_t i = 0; i < length; ++i) {
+        buf[i] = digits[length - 1 - i];
+    }
+    buf[length] = '\0';
+    return length;
+}
+
+// 一个子问题：把圆盘 base+1 .. base+disks 从 from 移到 to，spares 为可用的中间柱（位掩码）
+struct hanoi_multi_frame {
+    int disks;
+    int base;
+    uint32_t spares;
+    unsigned char from;
+    unsigned char to;
+    unsigned char stage;  // 0：移上面 k 个到中间柱；1：移剩下的；2：把 k 个移到目标柱
+};
+
+static void push(hanoi_multi_iter *it, int disks, int base, int from, int to, uint32_t spares) {
+    hanoi_multi_frame *f = &it->stack[it->top++];
+    f->disks = disks;
+    f->base = base;
+    f->spares = spares;
+    f->from = (unsigned char)from;
+    f->to = (unsigned char)to;
+    f->stage = 0;
+}
+
+int hanoi_multi_iter_init(hanoi_multi_iter *it, int n, int pegs) {
+    it->stack = NULL;
+    it->top = 0;
+    if (!valid(n, pegs) || extend_row(pegs, n) != 0) {
+        return -1;
+    }
+
+    // 每层子问题的圆盘数都比上一层少，栈深不超过 n
+    it->stack = malloc((size_t)(n + 1) * sizeof *it->stack);
+    if (it->stack == NULL) {
+        return -1;
+    }
+    const uint32_t spares = ((uint32_t)1 << (pegs - 1)) - 2;  // 1 .. p-2 号柱
+    push(it, n, 0, 0, pegs - 1, spares);
+    return 0;
+}
+
+int hanoi_multi_next(hanoi_multi_iter *it, hanoi_move *move) {
+    while (it->top > 0) {
+        hanoi_multi_frame *f = &it->stack[it->top - 1];
+        if (f->disks <= 1) {
+            --it->top;
+            if (f->disks == 1) {
+                move->disk = f->base + 1;
+                move->from = f->from;
+                move->to = f->to;
+                return 1;
+            }
+            continue;
+        }
+
+        const int pegs = 2 + __builtin_popcount(f->spares);
+        const int k = rows[pegs].split[f->disks];
+        const int via = __builtin_ctz(f->spares);
+        const uint32_t others = f->spares & ~((uint32_t)1 << via);
+
+        switch (f->stage) {
+        case 0:
+            f->stage = 1;
+            push(it, k, f->base, f->from, via, others | (uint32_t)1 << f->to);
+            break;
+        case 1:
+            f->stage = 2;
+            push(it, f->disks - k, f->base + k, f->from, f->to, others);
+            break;
+        default:
+            // 最后一个子问题直接替换当前层
+            --it->top;
+            push(it, k, f->base, via, f->to, others | (uint32_t)1 << f->from);
+            break;
+        }
+    }
+    return 0;
+}
+
+void hanoi_multi_iter_free(hanoi_multi_iter *it) {
+    free(it->stack);
+    it->stack = NULL;
+    it->top = 0;
+}
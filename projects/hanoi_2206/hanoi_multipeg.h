@@ -0,0 +1,57 @@
+#ifndef HANOI_MULTIPEG_H
+#define HANOI_MULTIPEG_H
+
+#include "hanoi_moves.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+p 根柱子（p >= 3）的汉诺塔，按 Frame–Stewart 算法求解：
+
+把上面 k 个圆盘借助全部 p 根柱子移到某根中间柱上，
+剩下的 n-k 个圆盘借助其余 p-1 根柱子移到目标柱，
+再把那 k 个圆盘借助全部 p 根柱子移到目标柱。
+总步数 FS(n, p) = min(2 FS(k, p) + FS(n-k, p-1))，FS(n, 3) = 2^n - 1。
+
+各 (n, p) 的最少步数和最优的 k 保存在备忘表中，按需扩展后一直保留，
+再次查询已算过的 n、p 只需查表。备忘表不是线程安全的。
+柱子编号为 0 到 p-1，0 号为起始柱，p-1 号为目标柱。
+*/
+
+// 支持的最大柱子数（柱子用字母 A 到 Z 表示）
+#define HANOI_MULTI_MAX_PEGS 26
+
+// 支持的最大圆盘数
+#define HANOI_MULTI_MAX_DISKS 10000
+
+// 128 位步数，不小于 HANOI_COUNT_MAX 的步数都记为 HANOI_COUNT_MAX
+__extension__ typedef unsigned __int128 hanoi_count;
+
+#define HANOI_COUNT_MAX (~(hanoi_count)0)
+
+// hanoi_count 的十进制最多位数
+#define HANOI_COUNT_DIGITS 39
+
+// n 个圆盘、p 根柱子的最少步数写入 *count；参数超出范围或内存不足时返回 -1
+int hanoi_multi_moves(int n, int pegs, hanoi_count *count);
+
+// 把 count 写成十进制字符串，buf 至少 HANOI_COUNT_DIGITS + 1 字节；返回字符串长度
+size_t hanoi_count_format(hanoi_count count, char *buf);
+
+// 按需生成移动步骤的迭代器，只保存递归的栈，不保存整个步骤序列
+typedef struct hanoi_multi_frame hanoi_multi_frame;
+
+typedef struct {
+    hanoi_multi_frame *stack;  // 最多 n 层
+    int top;
+} hanoi_multi_iter;
+
+// 初始化迭代器；参数超出范围或内存不足时返回 -1
+int hanoi_multi_iter_init(hanoi_multi_iter *it, int n, int pegs);
+
+// 生成下一步写入 *move（柱子编号为 0 到 p-1），返回 1；所有步骤都已生成时返回 0
+int hanoi_multi_next(hanoi_multi_iter *it, hanoi_move *move);
+
+void hanoi_multi_iter_free(hanoi_multi_iter *it);
+
+#endif // HANOI_MULTIPEG_H
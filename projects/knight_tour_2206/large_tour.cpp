@@ -0,0 +1,282 @@
+// 大棋盘闭合骑士之旅（分块拼接构造）
+#include "large_tour.h"
+
+#include "tour_blocks.h"
+
+#include <charconv>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+// 分块边长在 tour_blocks::SIZES 中的下标
+int size_index(const int size) { return (size - 6) / 2; }
+
+// 带缓冲的输出，满了才调用一次 fwrite
+class Writer {
+  public:
+    explicit Writer(std::FILE* out) : _out(out) {}
+    ~Writer() { flush(); }
+
+    void put_int(const int value, const int width = 0) {
+        char digits[16];
+        const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+        for (int pad = width - static_cast<int>(end - digits); pad > 0; pad--) {
+            put('0');
+        }
+        for (const char* p = digits; p != end; p++) {
+            put(*p);
+        }
+    }
+
+    void put(const char c) {
+        if (_size == sizeof(_buffer)) {
+            flush();
+        }
+        _buffer[_size++] = c;
+    }
+
+    void flush() {
+        std::fwrite(_buffer, 1, _size, _out);
+        _size = 0;
+    }
+
+  private:
+    std::FILE* _out;
+    char _buffer[1 << 16];
+    std::size_t _size = 0;
+};
+
+// 把邻居 from 替换为 to
+void replace(int out[2][2], const int from_x, const int from_y, const int to_x,
+             const int to_y) {
+    for (int i = 0; i < 2; i++) {
+        if (out[i][0] == from_x && out[i][1] == from_y) {
+            out[i][0] = to_x;
+            out[i][1] = to_y;
+            return;
+        }
+    }
+}
+
+} // namespace
+
+// 构造函数
+LargeTour::LargeTour(const int rows, const int cols)
+    : _rows(rows), _cols(cols) {
+    if (rows < 6 || cols < 6 || rows % 2 != 0 || cols % 2 != 0) {
+        throw std::invalid_argument("棋盘边长必须是不小于 6 的偶数");
+    }
+
+    // 预处理 9 种分块的前驱和后继
+    for (const int h : tour_blocks::SIZES) {
+        for (const int w : tour_blocks::SIZES) {
+            const std::uint8_t* steps = tour_blocks::block(h, w);
+            Block& b = _blocks[size_index(h)][size_index(w)];
+            b.prev.resize(h * w);
+            b.next.resize(h * w);
+
+            std::vector<std::uint8_t> order(h * w);
+            for (int i = 0; i < h * w; i++) {
+                order[steps[i] - 1] = static_cast<std::uint8_t>(i);
+            }
+            for (int s = 0; s < h * w; s++) {
+                b.next[order[s]] = order[(s + 1) % (h * w)];
+                b.prev[order[s]] = order[(s + h * w - 1) % (h * w)];
+            }
+        }
+    }
+
+    // 切分行和列
+    int start = 0;
+    for (const int part : split(rows)) {
+        _row_starts.push_back(start);
+        _row_block.insert(_row_block.end(), part,
+                          static_cast<int>(_row_starts.size()) - 1);
+        start += part;
+    }
+    _row_starts.push_back(start);
+
+    start = 0;
+    for (const int part : split(cols)) {
+        _col_starts.push_back(start);
+        _col_block.insert(_col_block.end(), part,
+                          static_cast<int>(_col_starts.size()) - 1);
+        start += part;
+    }
+    _col_starts.push_back(start);
+}
+
+// 把边长切成分块边长：尽量用 8，余数用一个 10 或一到两个 6 补齐
+std::vector<int> LargeTour::split(const int length) {
+    int eights = length / 8;
+    std::vector<int> parts;
+    switch (length % 8) {
+    case 2:
+        eights--;
+        parts.push_back(10);
+        break;
+    case 4:
+        eights--;
+        parts.push_back(6);
+        parts.push_back(6);
+        break;
+    case 6:
+        parts.push_back(6);
+        break;
+    default:
+        break;
+    }
+    parts.insert(parts.begin(), eights, 8);
+    return parts;
+}
+
+// 取分块 (h, w) 的回路
+const LargeTour::Block& LargeTour::block(const int h, const int w) const {
+    return _blocks[size_index(h)][size_index(w)];
+}
+
+// 求格子 (x, y) 在回路中的两个邻居
+void LargeTour::neighbors(const int x, const int y, int out[2][2]) const {
+    const int bi = _row_block[x];
+    const int bj = _col_block[y];
+    const int x0 = _row_starts[bi];
+    const int y0 = _col_starts[bj];
+    const int h = _row_starts[bi + 1] - x0;
+    const int w = _col_starts[bj + 1] - y0;
+    const Block& b = block(h, w);
+
+    // 块内回路的前驱和后继
+    const int lx = x - x0;
+    const int ly = y - y0;
+    const int prev = b.prev[lx * w + ly];
+    const int next = b.next[lx * w + ly];
+    out[0][0] = x0 + prev / w;
+    out[0][1] = y0 + prev % w;
+    out[1][0] = x0 + next / w;
+    out[1][1] = y0 + next % w;
+
+    const int last_row = static_cast<int>(_row_starts.size()) - 2;
+    const int last_col = static_cast<int>(_col_starts.size()) - 2;
+
+    // 与右侧分块拼接：拆掉 (0,w-1)-(2,w-2)，
+    // 连上 (0,w-1)-右块(1,1) 和 (2,w-2)-右块(3,0)
+    if (bj < last_col) {
+        const int right = y0 + w;
+        if (lx == 0 && ly == w - 1) {
+            replace(out, x0 + 2, y0 + w - 2, x0 + 1, right + 1);
+        } else if (lx == 2 && ly == w - 2) {
+            replace(out, x0, y0 + w - 1, x0 + 3, right);
+        }
+    }
+    // 与左侧分块拼接（上一条的另一半）
+    if (bj > 0) {
+        if (lx == 1 && ly == 1) {
+            replace(out, x0 + 3, y0, x0, y0 - 1);
+        } else if (lx == 3 && ly == 0) {
+            replace(out, x0 + 1, y0 + 1, x0 + 2, y0 - 2);
+        }
+    }
+    // 第一列的分块与下方分块拼接：拆掉 (h-1,0)-(h-2,2)，
+    // 连上 (h-1,0)-下块(1,1) 和 (h-2,2)-下块(0,3)
+    if (bj == 0 && bi < last_row) {
+        const int below = x0 + h;
+        if (lx == h - 1 && ly == 0) {
+            replace(out, x0 + h - 2, 2, below + 1, 1);
+        } else if (lx == h - 2 && ly == 2) {
+            replace(out, x0 + h - 1, 0, below, 3);
+        }
+    }
+    // 第一列的分块与上方分块拼接（上一条的另一半）
+    if (bj == 0 && bi > 0) {
+        if (lx == 1 && ly == 1) {
+            replace(out, x0, 3, x0 - 1, 0);
+        } else if (lx == 0 && ly == 3) {
+            replace(out, x0 + 1, 1, x0 - 2, 2);
+        }
+    }
+}
+
+// 沿回路遍历
+template <typename Visit> void LargeTour::walk(Visit&& visit) const {
+    int prev_x = -1;
+    int prev_y = -1;
+    int x = 0;
+    int y = 0;
+    const long long squares = static_cast<long long>(_rows) * _cols;
+
+    for (long long step = 1; step <= squares; step++) {
+        visit(step, x, y);
+
+        int n[2][2];
+        neighbors(x, y, n);
+        // 沿着不是来时的方向前进
+        const int k = (n[0][0] == prev_x && n[0][1] == prev_y) ? 1 : 0;
+        prev_x = x;
+        prev_y = y;
+        x = n[k][0];
+        y = n[k][1];
+    }
+}
+
+// 逐步输出走法
+void LargeTour::write_moves(std::FILE* out) const {
+    Writer writer(out);
+    walk([&](long long, const int x, const int y) {
+        writer.put_int(x);
+        writer.put(' ');
+        writer.put_int(y);
+        writer.put('\n');
+    });
+}
+
+// 输出步数棋盘
+void LargeTour::write_board(std::FILE* out) const {
+    std::vector<int> board(static_cast<std::size_t>(_rows) * _cols);
+    walk([&](const long long step, const int x, const int y) {
+        board[static_cast<std::size_t>(x) * _cols + y] = static_cast<int>(step);
+    });
+
+    int width = 1;
+    for (long long n = static_cast<long long>(_rows) * _cols; n >= 10; n /= 10) {
+        width++;
+    }
+
+    Writer writer(out);
+    for (int x = 0; x < _rows; x++) {
+        for (int y = 0; y < _cols; y++) {
+            writer.put_int(board[static_cast<std::size_t>(x) * _cols + y], width);
+            writer.put(' ');
+        }
+        writer.put('\n');
+    }
+}
+
+// 检查是否为合法的闭合骑士之旅
+bool LargeTour::verify() const {
+    std::vector<bool> visited(static_cast<std::size_t>(_rows) * _cols, false);
+    bool valid = true;
+    int last_x = -1;
+    int last_y = -1;
+
+    walk([&](long long, const int x, const int y) {
+        const std::size_t index = static_cast<std::size_t>(x) * _cols + y;
+        if (visited[index]) {
+            valid = false;
+        }
+        visited[index] = true;
+
+        if (last_x >= 0) {
+            const int dx = std::abs(x - last_x);
+            const int dy = std::abs(y - last_y);
+            if (dx * dy != 2) {
+                valid = false;
+            }
+        }
+        last_x = x;
+        last_y = y;
+    });
+
+    // 最后一格必须能一步马回到起点 (0,0)
+    return valid && last_x * last_y == 2;
+}
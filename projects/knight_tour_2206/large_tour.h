@@ -0,0 +1,61 @@
+// 大棋盘闭合骑士之旅（分块拼接构造）
+#ifndef KNIGHT_TOUR_LARGE_TOUR_H
+#define KNIGHT_TOUR_LARGE_TOUR_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// 大棋盘闭合骑士之旅
+//
+// 把 rows x cols 的棋盘（均为不小于 6 的偶数）切成 6/8/10 边长的分块，
+// 每块使用 tour_blocks.h 中预先算好的闭合回路，再把相邻分块的回路拼成一条：
+// 在两块各拆掉一条边，用两步跨块的马步交叉重连。
+// 每行分块从左到右拼接，各行再通过第一列的分块从上到下拼接。
+//
+// 任意格子在最终回路中的两个邻居都能 O(1) 算出，所以沿回路逐格输出时
+// 不需要递归，也不需要保存整个棋盘。
+class LargeTour {
+  public:
+    // 构造函数，rows 和 cols 必须是不小于 6 的偶数
+    LargeTour(const int rows, const int cols);
+
+    // 求格子 (x, y) 在回路中的两个邻居
+    void neighbors(const int x, const int y, int out[2][2]) const;
+    // 从 (0,0) 出发沿回路逐步输出 "x y" 走法，内存占用为常数
+    void write_moves(std::FILE* out) const;
+    // 输出步数棋盘（与 KnightTour::print_board 相同的格式）
+    void write_board(std::FILE* out) const;
+    // 沿回路走一遍，检查是否为合法的闭合骑士之旅
+    [[nodiscard]] bool verify() const;
+
+    [[nodiscard]] int rows() const { return _rows; }
+    [[nodiscard]] int cols() const { return _cols; }
+
+  private:
+    // 一个分块：回路上每格的前驱和后继（块内编号 x * w + y）
+    struct Block {
+        std::vector<std::uint8_t> prev;
+        std::vector<std::uint8_t> next;
+    };
+
+    // 沿回路遍历，对每一步调用 visit(step, x, y)
+    template <typename Visit> void walk(Visit&& visit) const;
+    // 把边长切成分块边长
+    static std::vector<int> split(const int length);
+    // 取分块 (h, w) 的回路
+    [[nodiscard]] const Block& block(const int h, const int w) const;
+
+    int _rows;
+    int _cols;
+    // 每个分块行/列的起始位置
+    std::vector<int> _row_starts;
+    std::vector<int> _col_starts;
+    // 每行/列所在的分块编号
+    std::vector<int> _row_block;
+    std::vector<int> _col_block;
+    // 3 x 3 种分块形状
+    Block _blocks[3][3];
+};
+
+#endif // KNIGHT_TOUR_LARGE_TOUR_H
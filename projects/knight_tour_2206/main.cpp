@@ -1,7 +1,91 @@
 #include "knight_tour.h"
+#include "large_tour.h"
+#include "tour_counter.h"
+
+#include <charconv>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+// 把整个字符串解析为整数，解析成功返回 true
+template <typename T>
+static bool parse_number(const std::string_view text, T& value) {
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+static int usage(const char* program) {
+    std::cerr << "用法: " << program << " count <棋盘边长 1-" << TourCounter::PRACTICAL_SIZE << "> [线程数]\n"
+              << "      " << program << " large <不小于 6 的偶数边长> [moves|board|verify] [输出文件]" << std::endl;
+    return 1;
+}
+
+// 计数模式：knight_tour count <棋盘边长> [线程数]
+static int count_tours(const int size, const unsigned threads) {
+    const TourCounter counter(size);
+    const TourCount result = counter.count(threads);
+
+    std::cout << size << "x" << size << " 棋盘:" << std::endl;
+    std::cout << "  有向骑士之旅: " << result.total << std::endl;
+    std::cout << "  开放: " << result.open() << std::endl;
+    std::cout << "  可闭合: " << result.closed << std::endl;
+    std::cout << "  闭合回路: " << result.closed_cycles(size) << std::endl;
+    return 0;
+}
+
+// 大棋盘模式：knight_tour large <棋盘边长> [moves|board|verify] [输出文件]
+static int large_tour(const int size, const std::string& mode,
+                      const char* path) {
+    const LargeTour tour(size, size);
+
+    if (mode == "verify") {
+        const bool valid = tour.verify();
+        std::cout << size << "x" << size << " 闭合骑士之旅"
+                  << (valid ? "验证通过" : "验证失败") << std::endl;
+        return valid ? 0 : 1;
+    }
+
+    std::FILE* out = path != nullptr ? std::fopen(path, "w") : stdout;
+    if (out == nullptr) {
+        std::cerr << "无法打开输出文件: " << path << std::endl;
+        return 1;
+    }
+    if (mode == "board") {
+        tour.write_board(out);
+    } else {
+        tour.write_moves(out);
+    }
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) try {
+    if (argc >= 2 && std::string(argv[1]) == "count") {
+        int size = 0;
+        unsigned threads = 0;
+        if (argc < 3 || argc > 4 || !parse_number(argv[2], size) || size < 1
+            || size > TourCounter::PRACTICAL_SIZE || (argc == 4 && !parse_number(argv[3], threads))) {
+            return usage(argv[0]);
+        }
+        return count_tours(size, threads);
+    }
+    if (argc >= 2 && std::string(argv[1]) == "large") {
+        int size = 0;
+        const std::string mode = argc >= 4 ? argv[3] : "moves";
+        if (argc < 3 || argc > 5 || !parse_number(argv[2], size) || size < 6 || size % 2 != 0
+            || (mode != "moves" && mode != "board" && mode != "verify")) {
+            return usage(argv[0]);
+        }
+        return large_tour(size, mode, argc >= 5 ? argv[4] : nullptr);
+    }
 
-int main() {
     KnightTour kt(0, 7);
     kt.start();
     return 0;
-}
\ No newline at end of file
+} catch (const std::exception& e) {
+    std::cerr << "错误: " << e.what() << std::endl;
+    return 1;
+}
@@ -0,0 +1,144 @@
+// 骑士之旅分块构造用的结构化闭合回路
+#ifndef KNIGHT_TOUR_TOUR_BLOCKS_H
+#define KNIGHT_TOUR_TOUR_BLOCKS_H
+
+#include <cstdint>
+
+// 每个分块是一条 h x w 的闭合骑士回路，按 print_board 的方式记录步数（1 起）。
+// 所有分块都包含以下四条边，供相邻分块拼接时拆开重连：
+//   左侧 (1,1)-(3,0)    右侧 (0,w-1)-(2,w-2)
+//   上侧 (1,1)-(0,3)    下侧 (h-1,0)-(h-2,2)
+// 这些表由一次离线的回溯搜索生成。
+namespace tour_blocks {
+
+// 分块边长只取 6、8、10
+constexpr int SIZES[] = {6, 8, 10};
+
+constexpr std::uint8_t BLOCK_6x6[6][6] = {
+    { 27,  18,  15,  36,  29,  34},
+    { 14,   1,  28,  33,  16,   7},
+    { 19,  26,  17,   8,  35,  30},
+    {  2,  13,  32,  23,   6,   9},
+    { 25,  20,  11,   4,  31,  22},
+    { 12,   3,  24,  21,  10,   5},
+};
+
+constexpr std::uint8_t BLOCK_6x8[6][8] = {
+    { 31,  40,  13,  48,  19,  28,  11,   8},
+    { 14,   1,  30,  41,  12,   9,  20,  27},
+    { 39,  32,  47,  18,  29,  42,   7,  10},
+    {  2,  15,  36,  43,  46,  21,  26,  23},
+    { 33,  38,  17,   4,  35,  24,  45,   6},
+    { 16,   3,  34,  37,  44,   5,  22,  25},
+};
+
+constexpr std::uint8_t BLOCK_6x10[6][10] = {
+    { 19,  40,  37,  60,  17,  58,  31,  10,  15,  12},
+    { 38,   1,  18,  49,  56,  45,  16,  13,  30,   9},
+    { 41,  20,  39,  36,  59,  50,  57,  32,  11,  14},
+    {  2,  23,  48,  55,  44,  35,  46,  51,   8,  29},
+    { 21,  42,  25,   4,  47,  54,  27,   6,  33,  52},
+    { 24,   3,  22,  43,  26,   5,  34,  53,  28,   7},
+};
+
+constexpr std::uint8_t BLOCK_8x6[8][6] = {
+    { 41,  16,  13,  48,  31,  46},
+    { 14,   1,  40,  45,  12,  33},
+    { 17,  42,  15,  32,  47,  30},
+    {  2,  23,  44,  39,  34,  11},
+    { 43,  18,  35,  22,  29,  38},
+    { 24,   3,  26,  37,  10,   7},
+    { 19,  36,   5,   8,  21,  28},
+    {  4,  25,  20,  27,   6,   9},
+};
+
+constexpr std::uint8_t BLOCK_8x8[8][8] = {
+    { 35,  18,  15,  64,  33,  40,  13,  10},
+    { 16,   1,  34,  39,  14,  11,  30,  41},
+    { 19,  36,  17,  32,  63,  42,   9,  12},
+    {  2,  53,  38,  47,  56,  31,  62,  29},
+    { 37,  20,  57,  54,  61,  48,  43,   8},
+    { 58,   3,  52,  23,  46,  55,  28,  49},
+    { 21,  24,   5,  60,  51,  26,   7,  44},
+    {  4,  59,  22,  25,   6,  45,  50,  27},
+};
+
+constexpr std::uint8_t BLOCK_8x10[8][10] = {
+    { 43,  20,  17,  80,  41,  48,  15,  60,  39,  58},
+    { 18,   1,  42,  47,  16,  79,  40,  57,  14,  61},
+    { 21,  44,  19,  78,  49,  56,  63,  68,  59,  38},
+    {  2,  51,  46,  55,  66,  77,  70,  37,  62,  13},
+    { 45,  22,  73,  50,  71,  36,  67,  64,  69,  28},
+    { 52,   3,  54,  35,  74,  65,  76,  29,  12,   9},
+    { 23,  34,   5,  72,  25,  32,   7,  10,  27,  30},
+    {  4,  53,  24,  33,   6,  75,  26,  31,   8,  11},
+};
+
+constexpr std::uint8_t BLOCK_10x6[10][6] = {
+    { 35,  30,  37,  60,  13,  32},
+    { 38,   1,  34,  31,  42,  11},
+    { 29,  36,  59,  12,  33,  14},
+    {  2,  39,  28,  43,  10,  41},
+    { 27,  58,  55,  40,  15,  24},
+    { 56,   3,  44,  25,  54,   9},
+    { 45,  26,  57,  52,  23,  16},
+    {  4,  51,  20,  47,   8,  53},
+    { 19,  46,  49,   6,  17,  22},
+    { 50,   5,  18,  21,  48,   7},
+};
+
+constexpr std::uint8_t BLOCK_10x8[10][8] = {
+    { 33,  30,  17,  80,  41,  38,  15,  12},
+    { 18,   1,  32,  37,  16,  13,  58,  39},
+    { 31,  34,  29,  42,  79,  40,  11,  14},
+    {  2,  19,  36,  61,  28,  59,  52,  57},
+    { 35,  66,  43,  68,  53,  78,  27,  10},
+    { 20,   3,  62,  71,  60,  69,  56,  51},
+    { 65,  44,  67,  54,  77,  50,   9,  26},
+    {  4,  21,  72,  63,  70,  55,  76,  49},
+    { 45,  64,  23,   6,  47,  74,  25,   8},
+    { 22,   5,  46,  73,  24,   7,  48,  75},
+};
+
+constexpr std::uint8_t BLOCK_10x10[10][10] = {
+    { 61,  98,  71, 100,  59,  18,  85,  14,  57,  16},
+    { 70,   1,  60,  93,  86,  83,  58,  17,  20,  13},
+    { 97,  62,  99,  72,  81,  88,  19,  84,  15,  56},
+    {  2,  69,  94,  87,  92,  73,  82,  79,  12,  21},
+    { 63,  96,  65,  38,  89,  80,  91,  22,  55,  78},
+    { 40,   3,  68,  95,  66,  47,  74,  77,  50,  11},
+    { 29,  64,  39,  46,  37,  90,  49,  54,  23,  76},
+    {  4,  41,  30,  67,  48,  45,  36,  75,  10,  51},
+    { 31,  28,  43,   6,  33,  26,  53,   8,  35,  24},
+    { 42,   5,  32,  27,  44,   7,  34,  25,  52,   9},
+};
+
+// 按 (h, w) 取分块，h 和 w 必须是 SIZES 中的值
+inline const std::uint8_t* block(const int h, const int w) {
+    switch (h * 100 + w) {
+    case 606:
+        return &BLOCK_6x6[0][0];
+    case 608:
+        return &BLOCK_6x8[0][0];
+    case 610:
+        return &BLOCK_6x10[0][0];
+    case 806:
+        return &BLOCK_8x6[0][0];
+    case 808:
+        return &BLOCK_8x8[0][0];
+    case 810:
+        return &BLOCK_8x10[0][0];
+    case 1006:
+        return &BLOCK_10x6[0][0];
+    case 1008:
+        return &BLOCK_10x8[0][0];
+    case 1010:
+        return &BLOCK_10x10[0][0];
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace tour_blocks
+
+#endif // KNIGHT_TOUR_TOUR_BLOCKS_H
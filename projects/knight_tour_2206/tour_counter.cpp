@@ -0,0 +1,179 @@
+// 骑士之旅计数（小棋盘穷举）
+#include "tour_counter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// 8个可能的移动方向（与 KnightTour::solve_tour 相同）
+constexpr int DX[] = {2, 1, -1, -2, -2, -1, 1, 2};
+constexpr int DY[] = {1, 2, 2, 1, -1, -2, -2, -1};
+
+// 任务前缀深度：起点之后再展开的步数
+constexpr int SPLIT_DEPTH = 3;
+
+} // namespace
+
+// 闭合回路数
+std::uint64_t TourCount::closed_cycles(const int size) const {
+    // 每条回路可以从任意格子出发、沿两个方向走
+    const auto squares = static_cast<std::uint64_t>(size) * size;
+    return squares == 0 ? 0 : closed / (2 * squares);
+}
+
+// 构造函数
+TourCounter::TourCounter(const int size) : _size(size) {
+    if (size < 1 || size > MAX_SIZE) {
+        throw std::invalid_argument("棋盘边长必须在 1 到 8 之间");
+    }
+
+    // 预计算每格的可达格子
+    for (int x = 0; x < size; x++) {
+        for (int y = 0; y < size; y++) {
+            std::uint64_t mask = 0;
+            for (int i = 0; i < 8; i++) {
+                const int nx = x + DX[i];
+                const int ny = y + DY[i];
+                if (nx >= 0 && nx < size && ny >= 0 && ny < size) {
+                    mask |= std::uint64_t{1} << (nx * size + ny);
+                }
+            }
+            _moves[x * size + y] = mask;
+        }
+    }
+}
+
+// 起点在对称群下的轨道大小
+int TourCounter::orbit_weight(const int x, const int y) const {
+    const int m = _size - 1;
+    // 旋转和翻转得到的 8 个像
+    const int images[8][2] = {{x, y},         {y, m - x},     {m - x, m - y},
+                              {m - y, x},     {y, x},         {m - x, y},
+                              {m - y, m - x}, {x, m - y}};
+
+    const int self = x * _size + y;
+    std::uint64_t seen = 0;
+    for (const auto& img : images) {
+        const int index = img[0] * _size + img[1];
+        // 只有编号最小的像才是规范起点
+        if (index < self) {
+            return 0;
+        }
+        seen |= std::uint64_t{1} << index;
+    }
+    return std::popcount(seen);
+}
+
+// 展开任务前缀
+void TourCounter::expand(std::vector<Task>& tasks, const Task& task,
+                         const int depth) const {
+    const std::uint64_t next = _moves[task.cur] & task.free;
+    if (depth == 0 || next == 0) {
+        tasks.push_back(task);
+        return;
+    }
+
+    for (std::uint64_t bits = next; bits != 0; bits &= bits - 1) {
+        const int sq = std::countr_zero(bits);
+        const Task child{task.free & ~(std::uint64_t{1} << sq), sq, task.start,
+                         task.weight};
+        expand(tasks, child, depth - 1);
+    }
+}
+
+// 生成所有子树任务
+std::vector<TourCounter::Task> TourCounter::split_tasks() const {
+    const int squares = _size * _size;
+    const std::uint64_t all = squares == 64 ? ~std::uint64_t{0}
+                                            : (std::uint64_t{1} << squares) - 1;
+
+    std::vector<Task> tasks;
+    for (int x = 0; x < _size; x++) {
+        for (int y = 0; y < _size; y++) {
+            const int weight = orbit_weight(x, y);
+            if (weight == 0) {
+                continue;
+            }
+            const int sq = x * _size + y;
+            const Task root{all & ~(std::uint64_t{1} << sq), sq, sq,
+                            static_cast<std::uint64_t>(weight)};
+            expand(tasks, root, SPLIT_DEPTH);
+        }
+    }
+    return tasks;
+}
+
+// 回溯计数
+void TourCounter::dfs(const int cur, const std::uint64_t free,
+                      const std::uint64_t start_bit, TourCount& out) const {
+    // 所有格子都已访问，找到一条骑士之旅
+    if (free == 0) {
+        out.total++;
+        if (_moves[cur] & start_bit) {
+            out.closed++;
+        }
+        return;
+    }
+
+    const std::uint64_t next = _moves[cur] & free;
+
+    // 剪枝：某个可达格若除当前格外已无未访问的邻居，
+    // 它只能作为终点，此时必须只剩它一个格子
+    for (std::uint64_t bits = next; bits != 0; bits &= bits - 1) {
+        const int sq = std::countr_zero(bits);
+        if ((_moves[sq] & free) == 0) {
+            if (free == (std::uint64_t{1} << sq)) {
+                dfs(sq, 0, start_bit, out);
+            }
+            return;
+        }
+    }
+
+    // 尝试所有可达格子
+    for (std::uint64_t bits = next; bits != 0; bits &= bits - 1) {
+        const int sq = std::countr_zero(bits);
+        dfs(sq, free & ~(std::uint64_t{1} << sq), start_bit, out);
+    }
+}
+
+// 计数
+TourCount TourCounter::count(unsigned threads) const {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const std::vector<Task> tasks = split_tasks();
+    std::vector<TourCount> partial(threads);
+    std::atomic<std::size_t> next_task{0};
+
+    // 每个线程从共享队列中领取任务，直到任务耗尽
+    auto worker = [&](const unsigned id) {
+        TourCount& sum = partial[id];
+        for (std::size_t i = next_task.fetch_add(1); i < tasks.size();
+             i = next_task.fetch_add(1)) {
+            const Task& task = tasks[i];
+            TourCount local;
+            dfs(task.cur, task.free, std::uint64_t{1} << task.start, local);
+            sum.total += local.total * task.weight;
+            sum.closed += local.closed * task.weight;
+        }
+    };
+
+    std::vector<std::jthread> pool;
+    for (unsigned id = 1; id < threads; id++) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    pool.clear();
+
+    TourCount result;
+    for (const TourCount& c : partial) {
+        result.total += c.total;
+        result.closed += c.closed;
+    }
+    return result;
+}
@@ -1,59 +1,86 @@
-#ifndef MORSE_CODE_HPP
-#define MORSE_CODE_HPP
-
-#include <string>
-#include <string_view>
-#include <unordered_map>
-#include <vector>
-#include <optional>
-
-namespace morse {
-
-/**
- * MorseCode - 摩尔斯电码编码器/解码器
- *
- * 支持：
- * - 字母 A-Z (大小写不敏感)
- * - 数字 0-9
- * - 英文短语编码/解码
- *
- * 编码规则：
- * - 字母之间用单个空格分隔
- * - 单词之间用三个空格分隔
- */
-class MorseCode {
-public:
-    MorseCode();
-
-    // 将文本编码为摩尔斯电码
-    [[nodiscard]] std::string encode(std::string_view text) const;
-
-    // 将摩尔斯电码解码为文本
-    [[nodiscard]] std::string decode(std::string_view morse) const;
-
-    // 检查字符是否可编码
-    [[nodiscard]] bool isEncodable(char c) const;
-
-    // 检查摩尔斯电码是否有效
-    [[nodiscard]] bool isValidMorse(std::string_view morse) const;
-
-    // 获取单个字符的摩尔斯电码
-    [[nodiscard]] std::optional<std::string> charToMorse(char c) const;
-
-    // 获取摩尔斯电码对应的字符
-    [[nodiscard]] std::optional<char> morseToChar(std::string_view morse) const;
-
-private:
-    std::unordered_map<char, std::string> char_to_morse_;
-    std::unordered_map<std::string, char> morse_to_char_;
-
-    void initializeMaps();
-
-    // 分割字符串
-    [[nodiscard]] std::vector<std::string> split(std::string_view str,
-                                                  std::string_view delimiter) const;
-};
-
-} // namespace morse
-
-#endif // MORSE_CODE_HPP
+#ifndef MORSE_CODE_HPP
+#define MORSE_CODE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <optional>
+
+namespace morse {
+
+/**
+ * MorseCode - 摩尔斯电码编码器/解码器
+ *
+ * 支持：
+ * - 字母 A-Z (大小写不敏感)
+ * - 数字 0-9
+ * - 英文短语编码/解码
+ *
+ * 编码规则：
+ * - 字母之间用单个空格分隔
+ * - 单词之间用三个空格分隔
+ *
+ * 编码和解码都只查编译期生成的表（见 morse_table.hpp），
+ * encodeTo/decodeTo 直接写入调用者提供的缓冲区，不分配内存。
+ * encodeChunk/decodeChunk 把跨块的状态保存在 EncodeState/DecodeState 中，
+ * 输入可以在任意位置切开分块处理，结果与整体处理相同。
+ */
+class MorseCode {
+public:
+    // 分块编码的状态
+    struct EncodeState {
+        bool in_word = false;  // 当前单词中是否已经输出过字符
+    };
+
+    // 分块解码的状态
+    struct DecodeState {
+        unsigned node = 1;  // 未结束的电码在解码树中的位置，1 表示不在电码中
+        int spaces = 0;     // 尚未凑满三个的连续空格数
+    };
+
+    MorseCode() = default;
+
+    // 编码 n 个字符最多产生的字节数（每个字符最多 5 个符号加 1 个分隔空格）
+    [[nodiscard]] static constexpr std::size_t maxEncodedSize(std::size_t n) { return n * 6; }
+
+    // 解码 n 个字节最多产生的字符数
+    [[nodiscard]] static constexpr std::size_t maxDecodedSize(std::size_t n) { return n; }
+
+    // 将文本编码为摩尔斯电码
+    [[nodiscard]] std::string encode(std::string_view text) const;
+
+    // 将摩尔斯电码解码为文本
+    [[nodiscard]] std::string decode(std::string_view morse) const;
+
+    // 编码到 out，out 至少要有 maxEncodedSize(text.size()) 字节，返回写入的字节数
+    std::size_t encodeTo(std::string_view text, char* out) const;
+
+    // 解码到 out，out 至少要有 maxDecodedSize(morse.size()) 字节，返回写入的字节数
+    std::size_t decodeTo(std::string_view morse, char* out) const;
+
+    // 编码一块输入，接着 state 继续；out 的要求与 encodeTo 相同
+    std::size_t encodeChunk(std::string_view text, EncodeState& state, char* out) const;
+
+    // 解码一块输入，接着 state 继续；末尾没结束的电码留在 state 中，
+    // out 的要求与 decodeTo 相同
+    std::size_t decodeChunk(std::string_view morse, DecodeState& state, char* out) const;
+
+    // 输入结束：输出 state 中剩下的电码（最多 1 字节）并重置 state
+    std::size_t decodeFinish(DecodeState& state, char* out) const;
+
+    // 检查字符是否可编码
+    [[nodiscard]] bool isEncodable(char c) const;
+
+    // 检查摩尔斯电码是否有效
+    [[nodiscard]] bool isValidMorse(std::string_view morse) const;
+
+    // 获取单个字符的摩尔斯电码
+    [[nodiscard]] std::optional<std::string> charToMorse(char c) const;
+
+    // 获取摩尔斯电码对应的字符
+    [[nodiscard]] std::optional<char> morseToChar(std::string_view morse) const;
+};
+
+} // namespace morse
+
+#endif // MORSE_CODE_HPP
@@ -0,0 +1,37 @@
+#ifndef MORSE_PARALLEL_HPP
+#define MORSE_PARALLEL_HPP
+
+#include "morse_code.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace morse {
+
+/**
+ * 并行解码 - 把长电码切成若干块，由多个线程分别解码
+ *
+ * 空格与点划之间的每个交界处（电码的开头或结尾）都是干净的切分点：
+ * 在这里切开后各块单独解码，拼接起来与整体解码的结果相同。
+ * 每块的输出不超过它的输入长度，所以各线程直接解码到输出缓冲区中
+ * 该块输入所在的位置，全部完成后按输出长度的前缀和依次前移拼接。
+ */
+
+// 每块的目标大小
+inline constexpr std::size_t PARALLEL_CHUNK_SIZE = std::size_t{1} << 22;
+
+// from 之后（含 from）第一个切分点；没有时返回 morse.size()
+[[nodiscard]] std::size_t nextSplitPoint(std::string_view morse, std::size_t from);
+
+// 并行解码到 out，out 至少要有 MorseCode::maxDecodedSize(morse.size()) 字节，
+// 返回写入的字节数；threads 为 0 时使用全部硬件线程
+std::size_t decodeParallelTo(const MorseCode& mc, std::string_view morse, char* out,
+                             unsigned threads = 0, std::size_t chunk_size = PARALLEL_CHUNK_SIZE);
+
+// 并行解码，结果与 MorseCode::decode 相同
+[[nodiscard]] std::string decodeParallel(const MorseCode& mc, std::string_view morse,
+                                         unsigned threads = 0);
+
+} // namespace morse
+
+#endif // MORSE_PARALLEL_HPP
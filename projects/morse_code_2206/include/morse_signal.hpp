@@ -0,0 +1,59 @@
+#ifndef MORSE_SIGNAL_HPP
+#define MORSE_SIGNAL_HPP
+
+#include "morse_code.hpp"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace morse {
+
+/**
+ * 信号前端 - 从录音或通断采样中解码摩尔斯电码（离线处理）
+ *
+ * 处理流程：
+ * 1. 按固定长度分块，用 Goertzel 算法求每块在音调频率上的能量
+ *    （未指定频率时先在候选频率中找能量最大的一个）
+ * 2. 把各块能量的对数分成两类（有音调 / 无音调），得到通断序列，
+ *    再用 3 点中值滤波去掉单块的毛刺
+ * 3. 统计通断段的长度：从最短的一类段估计点的长度，解码过程中
+ *    随每个点、划和符号间隔不断修正，以适应手键速度的变化
+ * 4. 点划累积成电码后交给 MorseCode::morseToChar，无法识别的电码被忽略
+ */
+
+// 采样信号：单声道，取值范围约为 [-1, 1]
+struct Signal {
+    unsigned sample_rate = 0;
+    std::vector<float> samples;
+};
+
+struct SignalOptions {
+    double frequency = 0;   // 音调频率 (Hz)，为 0 时自动检测
+    double block_ms = 5;    // 分块长度 (毫秒)，决定时间分辨率
+};
+
+struct SignalResult {
+    std::string text;
+    double frequency = 0;   // 使用的音调频率，通断输入时为 0
+    double wpm = 0;         // 估计的平均速度 (每分钟单词数)
+};
+
+// 读取 WAV 文件：支持 8/16/24/32 位整数和 32 位浮点 PCM，多声道取平均；
+// 格式不支持或文件损坏时返回 nullopt
+[[nodiscard]] std::optional<Signal> readWav(const std::string& filename);
+
+// 读取通断采样：每个字符 '0' 或 '1'（也可以是字节 0 或 1）为一个采样，其他字符被忽略
+[[nodiscard]] std::optional<Signal> readKeying(const std::string& filename, unsigned sample_rate);
+
+// 从音频中解码
+[[nodiscard]] SignalResult decodeTone(const MorseCode& mc, const Signal& signal,
+                                      const SignalOptions& options = {});
+
+// 从通断采样中解码（采样大于 0.5 为按下）
+[[nodiscard]] SignalResult decodeKeying(const MorseCode& mc, const Signal& signal,
+                                        const SignalOptions& options = {});
+
+} // namespace morse
+
+#endif // MORSE_SIGNAL_HPP
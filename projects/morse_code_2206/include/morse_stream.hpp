@@ -0,0 +1,42 @@
+#ifndef MORSE_STREAM_HPP
+#define MORSE_STREAM_HPP
+
+#include "morse_code.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace morse {
+
+/**
+ * 流式转换 - 用 read/write 在两个文件描述符之间分块编码或解码
+ *
+ * 每次读入固定大小的一块，用 MorseCode::encodeChunk/decodeChunk 处理后
+ * 一次写出，块之间的状态由 EncodeState/DecodeState 携带。
+ * 内存占用只取决于块大小，与输入长度无关，可以处理管道和任意大的文件。
+ */
+enum class Direction { Encode, Decode };
+
+// 一次转换读入和写出的字节数
+struct StreamStats {
+    std::uint64_t bytes_in = 0;
+    std::uint64_t bytes_out = 0;
+};
+
+// 默认块大小：能放进 L2 缓存，编码时的输出缓冲区也不会太大
+inline constexpr std::size_t DEFAULT_CHUNK_SIZE = std::size_t{1} << 18;
+
+// 从 in_fd 读到结束，转换后写入 out_fd；读写出错时返回 nullopt，errno 保留出错原因
+[[nodiscard]] std::optional<StreamStats> transcode(const MorseCode& mc, int in_fd, int out_fd,
+                                                   Direction direction,
+                                                   std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+// 并行解码：普通文件映射到内存后按窗口用 decodeParallelTo 解码并逐个窗口写出，
+// 窗口在切分点处断开；无法映射的输入（管道等）退回单线程的 transcode。
+// threads 为 0 时使用全部硬件线程
+[[nodiscard]] std::optional<StreamStats> decodeParallel(const MorseCode& mc, int in_fd, int out_fd,
+                                                        unsigned threads = 0);
+
+} // namespace morse
+
+#endif // MORSE_STREAM_HPP
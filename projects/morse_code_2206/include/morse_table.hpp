@@ -0,0 +1,103 @@
+#ifndef MORSE_TABLE_HPP
+#define MORSE_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace morse {
+namespace table {
+
+/**
+ * 编译期生成的摩尔斯电码查找表
+ *
+ * 编码表 ENCODE：按字节值索引的 256 项，每项一个字节，
+ * 高 3 位为电码长度（1-5），低 5 位为点划（第 i 位为 1 表示第 i 个符号是划）；
+ * 0 表示不可编码。字母大小写都有对应项。
+ *
+ * 解码树 DECODE：从下标 1 开始，遇到点走到 2i，遇到划走到 2i+1，
+ * 最长 5 个符号，所以有效下标都小于 64。下标 INVALID 用于标记无效的电码，
+ * 继续走下去也停留在 INVALID。
+ */
+
+struct Code {
+    char ch;
+    const char* code;
+};
+
+inline constexpr Code CODES[] = {
+    {'0', "-----"}, {'1', ".----"}, {'2', "..---"}, {'3', "...--"}, {'4', "....-"},
+    {'5', "....."}, {'6', "-...."}, {'7', "--..."}, {'8', "---.."}, {'9', "----."},
+    {'A', ".-"},    {'B', "-..."},  {'C', "-.-."},  {'D', "-.."},   {'E', "."},
+    {'F', "..-."},  {'G', "--."},   {'H', "...."},  {'I', ".."},    {'J', ".---"},
+    {'K', "-.-"},   {'L', ".-.."},  {'M', "--"},    {'N', "-."},    {'O', "---"},
+    {'P', ".--."},  {'Q', "--.-"},  {'R', ".-."},   {'S', "..."},   {'T', "-"},
+    {'U', "..-"},   {'V', "...-"},  {'W', ".--"},   {'X', "-..-"},  {'Y', "-.--"},
+    {'Z', "--.."},
+};
+
+// 最长电码的符号数
+inline constexpr int MAX_CODE_LENGTH = 5;
+
+// 无效电码在解码树中的下标
+inline constexpr unsigned INVALID = 64;
+
+constexpr std::uint8_t pack(const char* code) {
+    std::uint8_t bits = 0;
+    std::uint8_t length = 0;
+    for (; code[length] != '\0'; ++length) {
+        if (code[length] == '-') {
+            bits |= static_cast<std::uint8_t>(1u << length);
+        }
+    }
+    return static_cast<std::uint8_t>(length << 5 | bits);
+}
+
+constexpr int codeLength(std::uint8_t packed) {
+    return packed >> 5;
+}
+
+constexpr bool isDash(std::uint8_t packed, int i) {
+    return (packed >> i & 1u) != 0;
+}
+
+// 解码树上走一步；超过最长电码或已经无效时停在 INVALID
+constexpr unsigned step(unsigned node, bool dash) {
+    return node < 32 ? node * 2 + (dash ? 1u : 0u) : INVALID;
+}
+
+constexpr std::array<std::uint8_t, 256> makeEncodeTable() {
+    std::array<std::uint8_t, 256> table{};
+    for (const Code& c : CODES) {
+        const std::uint8_t packed = pack(c.code);
+        table[static_cast<unsigned char>(c.ch)] = packed;
+        if (c.ch >= 'A' && c.ch <= 'Z') {
+            table[static_cast<unsigned char>(c.ch - 'A' + 'a')] = packed;
+        }
+    }
+    return table;
+}
+
+constexpr std::array<char, INVALID + 1> makeDecodeTable() {
+    std::array<char, INVALID + 1> table{};
+    for (const Code& c : CODES) {
+        unsigned node = 1;
+        for (const char* p = c.code; *p != '\0'; ++p) {
+            node = step(node, *p == '-');
+        }
+        table[node] = c.ch;
+    }
+    return table;
+}
+
+inline constexpr std::array<std::uint8_t, 256> ENCODE = makeEncodeTable();
+inline constexpr std::array<char, INVALID + 1> DECODE = makeDecodeTable();
+
+static_assert(ENCODE['S'] == pack("...") && ENCODE['s'] == ENCODE['S']);
+static_assert(DECODE[step(step(1, false), true)] == 'A');
+static_assert(DECODE[1] == '\0' && DECODE[INVALID] == '\0');
+
+} // namespace table
+} // namespace morse
+
+#endif // MORSE_TABLE_HPP
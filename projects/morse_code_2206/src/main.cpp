@@ -1,105 +1,230 @@
-#include "morse_code.hpp"
-#include <iostream>
-#include <string>
-
-void printSeparator() {
-    std::cout << std::string(50, '-') << '\n';
-}
-
-void demonstrateEncoding(const morse::MorseCode& mc) {
-    std::cout << "=== 文本 -> 摩尔斯电码 ===\n\n";
-
-    std::string examples[] = {
-        "HELLO WORLD",
-        "SOS",
-        "HELLO",
-        "2024"
-    };
-
-    for (const auto& text : examples) {
-        std::string encoded = mc.encode(text);
-        std::cout << "原文: " << text << '\n';
-        std::cout << "编码: " << encoded << '\n';
-        printSeparator();
-    }
-}
-
-void demonstrateDecoding(const morse::MorseCode& mc) {
-    std::cout << "\n=== 摩尔斯电码 -> 文本 ===\n\n";
-
-    std::string morse_examples[] = {
-        ".... . .-.. .-.. ---   .-- --- .-. .-.. -..",
-        "... --- ...",
-        ".- -... -.-."
-    };
-
-    for (const auto& morse : morse_examples) {
-        std::string decoded = mc.decode(morse);
-        std::cout << "电码: " << morse << '\n';
-        std::cout << "解码: " << decoded << '\n';
-        printSeparator();
-    }
-}
-
-void interactiveMode(const morse::MorseCode& mc) {
-    std::cout << "\n=== 交互模式 ===\n";
-    std::cout << "输入 'e' 进入编码模式\n";
-    std::cout << "输入 'd' 进入解码模式\n";
-    std::cout << "输入 'q' 退出\n\n";
-
-    std::string mode;
-    while (true) {
-        std::cout << "选择模式 (e/d/q): ";
-        std::getline(std::cin, mode);
-
-        if (mode == "q" || mode == "Q") {
-            std::cout << "再见!\n";
-            break;
-        }
-
-        if (mode == "e" || mode == "E") {
-            std::cout << "输入要编码的文本: ";
-            std::string text;
-            std::getline(std::cin, text);
-            std::string encoded = mc.encode(text);
-            std::cout << "摩尔斯电码: " << encoded << "\n\n";
-        } else if (mode == "d" || mode == "D") {
-            std::cout << "输入摩尔斯电码 (字符间用空格, 单词间用三个空格): ";
-            std::string morse;
-            std::getline(std::cin, morse);
-            std::string decoded = mc.decode(morse);
-            std::cout << "解码结果: " << decoded << "\n\n";
-        } else {
-            std::cout << "无效选项，请重新输入\n";
-        }
-    }
-}
-
-int main() {
-    morse::MorseCode mc;
-
-    std::cout << "╔══════════════════════════════════════╗\n";
-    std::cout << "║      摩尔斯电码编码器/解码器         ║\n";
-    std::cout << "╚══════════════════════════════════════╝\n\n";
-
-    // 演示编码
-    demonstrateEncoding(mc);
-    // 演示解码
-    demonstrateDecoding(mc);
-
-    // 验证往返转换
-    std::cout << "\n=== 往返转换验证 ===\n\n";
-    const std::string original = "HELLO WORLD";
-    const std::string encoded = mc.encode(original);
-    const std::string decoded = mc.decode(encoded);
-    std::cout << "原文: " << original << '\n';
-    std::cout << "编码: " << encoded << '\n';
-    std::cout << "解码: " << decoded << '\n';
-    std::cout << "验证: " << (original == decoded ? "通过" : "失败") << '\n';
-    printSeparator();
-
-    // 交互模式
-    interactiveMode(mc);
-
-    return 0;
-}
+#include "morse_code.hpp"
+#include "morse_signal.hpp"
+#include "morse_stream.hpp"
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+void printSeparator() {
+    std::cout << std::string(50, '-') << '\n';
+}
+
+void demonstrateEncoding(const morse::MorseCode& mc) {
+    std::cout << "=== 文本 -> 摩尔斯电码 ===\n\n";
+
+    std::string examples[] = {
+        "HELLO WORLD",
+        "SOS",
+        "HELLO",
+        "2024"
+    };
+
+    for (const auto& text : examples) {
+        std::string encoded = mc.encode(text);
+        std::cout << "原文: " << text << '\n';
+        std::cout << "编码: " << encoded << '\n';
+        printSeparator();
+    }
+}
+
+void demonstrateDecoding(const morse::MorseCode& mc) {
+    std::cout << "\n=== 摩尔斯电码 -> 文本 ===\n\n";
+
+    std::string morse_examples[] = {
+        ".... . .-.. .-.. ---   .-- --- .-. .-.. -..",
+        "... --- ...",
+        ".- -... -.-."
+    };
+
+    for (const auto& morse : morse_examples) {
+        std::string decoded = mc.decode(morse);
+        std::cout << "电码: " << morse << '\n';
+        std::cout << "解码: " << decoded << '\n';
+        printSeparator();
+    }
+}
+
+void interactiveMode(const morse::MorseCode& mc) {
+    std::cout << "\n=== 交互模式 ===\n";
+    std::cout << "输入 'e' 进入编码模式\n";
+    std::cout << "输入 'd' 进入解码模式\n";
+    std::cout << "输入 'q' 退出\n\n";
+
+    std::string mode;
+    while (true) {
+        std::cout << "选择模式 (e/d/q): ";
+        std::getline(std::cin, mode);
+
+        if (mode == "q" || mode == "Q") {
+            std::cout << "再见!\n";
+            break;
+        }
+
+        if (mode == "e" || mode == "E") {
+            std::cout << "输入要编码的文本: ";
+            std::string text;
+            std::getline(std::cin, text);
+            std::string encoded = mc.encode(text);
+            std::cout << "摩尔斯电码: " << encoded << "\n\n";
+        } else if (mode == "d" || mode == "D") {
+            std::cout << "输入摩尔斯电码 (字符间用空格, 单词间用三个空格): ";
+            std::string morse;
+            std::getline(std::cin, morse);
+            std::string decoded = mc.decode(morse);
+            std::cout << "解码结果: " << decoded << "\n\n";
+        } else {
+            std::cout << "无效选项，请重新输入\n";
+        }
+    }
+}
+
+void printUsage(const char* program) {
+    std::cerr << "用法: " << program << "  (演示 + 交互模式)\n";
+    std::cerr << "      " << program << " --encode|--decode [输入 [输出]]  (流式编码/解码)\n";
+    std::cerr << "      " << program << " --decode [输入 [输出]] --threads T  (多线程解码，T 为 0 时使用全部核心)\n";
+    std::cerr << "      " << program << " --wav 文件 [--freq 频率]  (从录音解码，不指定频率时自动检测)\n";
+    std::cerr << "      " << program << " --keying 文件 --rate 采样率  (从 0/1 通断采样解码)\n";
+    std::cerr << "输入、输出省略或为 - 时使用标准输入、标准输出\n";
+}
+
+// 解析整个字符串为一个数
+template <typename T>
+bool parseNumber(std::string_view text, T& value) {
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+// 从录音或通断采样解码，结果写到标准输出，返回进程退出码
+int signalMode(const morse::MorseCode& mc, bool keying, const char* path, double value) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto signal = keying ? morse::readKeying(path, static_cast<unsigned>(value)) : morse::readWav(path);
+    if (!signal) {
+        std::cerr << "无法读取 " << path << '\n';
+        return 1;
+    }
+
+    morse::SignalOptions options;
+    if (!keying) options.frequency = value;
+    const morse::SignalResult result =
+        keying ? morse::decodeKeying(mc, *signal, options) : morse::decodeTone(mc, *signal, options);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << result.text << '\n';
+
+    const double duration = static_cast<double>(signal->samples.size()) / signal->sample_rate;
+    std::cerr << "时长 " << duration << " 秒";
+    if (!keying) std::cerr << "，音调 " << result.frequency << " Hz";
+    std::cerr << "，速度约 " << result.wpm << " WPM，用时 " << elapsed.count() << " 秒 ("
+              << duration / elapsed.count() << " 倍实时)\n";
+    return 0;
+}
+
+// 流式转换文件或管道，指定 threads 时并行解码，返回进程退出码
+int streamMode(const morse::MorseCode& mc, morse::Direction direction,
+               const char* input, const char* output, const std::optional<unsigned> threads) {
+    const auto isStd = [](const char* path) { return path == nullptr || std::strcmp(path, "-") == 0; };
+
+    const int in_fd = isStd(input) ? STDIN_FILENO : ::open(input, O_RDONLY);
+    if (in_fd < 0) {
+        std::cerr << "无法打开输入文件 " << input << ": " << std::strerror(errno) << '\n';
+        return 1;
+    }
+    const int out_fd = isStd(output) ? STDOUT_FILENO : ::open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0) {
+        std::cerr << "无法打开输出文件 " << output << ": " << std::strerror(errno) << '\n';
+        if (in_fd != STDIN_FILENO) ::close(in_fd);
+        return 1;
+    }
+
+    const auto stats = threads ? morse::decodeParallel(mc, in_fd, out_fd, *threads)
+                               : morse::transcode(mc, in_fd, out_fd, direction);
+    const int error = errno;
+    if (in_fd != STDIN_FILENO) ::close(in_fd);
+    if (out_fd != STDOUT_FILENO && ::close(out_fd) != 0 && stats) {
+        std::cerr << "写入失败: " << std::strerror(errno) << '\n';
+        return 1;
+    }
+    if (!stats) {
+        std::cerr << "读写失败: " << std::strerror(error) << '\n';
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    morse::MorseCode mc;
+
+    if (argc > 1 && (std::strcmp(argv[1], "--wav") == 0 || std::strcmp(argv[1], "--keying") == 0)) {
+        const bool keying = std::strcmp(argv[1], "--keying") == 0;
+        const char* option = keying ? "--rate" : "--freq";
+        double value = 0;
+        const bool valid = (argc == 3 && !keying) ||
+                           (argc == 5 && std::strcmp(argv[3], option) == 0 && parseNumber(argv[4], value) && value > 0);
+        if (!valid) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        return signalMode(mc, keying, argv[2], value);
+    }
+
+    if (argc > 1) {
+        const std::string mode = argv[1];
+        const char* paths[2] = {nullptr, nullptr};
+        int path_count = 0;
+        std::optional<unsigned> threads;
+        bool valid = mode == "--encode" || mode == "--decode";
+
+        for (int i = 2; valid && i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--threads" && i + 1 < argc && mode == "--decode") {
+                unsigned count = 0;
+                valid = parseNumber(argv[++i], count);
+                threads = count;
+            } else if (path_count < 2 && arg.rfind("--", 0) != 0) {
+                paths[path_count++] = argv[i];
+            } else {
+                valid = false;
+            }
+        }
+
+        if (!valid) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        return streamMode(mc, mode == "--encode" ? morse::Direction::Encode : morse::Direction::Decode,
+                          paths[0], paths[1], threads);
+    }
+
+    std::cout << "╔══════════════════════════════════════╗\n";
+    std::cout << "║      摩尔斯电码编码器/解码器         ║\n";
+    std::cout << "╚══════════════════════════════════════╝\n\n";
+
+    // 演示编码
+    demonstrateEncoding(mc);
+    // 演示解码
+    demonstrateDecoding(mc);
+
+    // 验证往返转换
+    std::cout << "\n=== 往返转换验证 ===\n\n";
+    const std::string original = "HELLO WORLD";
+    const std::string encoded = mc.encode(original);
+    const std::string decoded = mc.decode(encoded);
+    std::cout << "原文: " << original << '\n';
+    std::cout << "编码: " << encoded << '\n';
+    std::cout << "解码: " << decoded << '\n';
+    std::cout << "验证: " << (original == decoded ? "通过" : "失败") << '\n';
+    printSeparator();
+
+    // 交互模式
+    interactiveMode(mc);
+
+    return 0;
+}
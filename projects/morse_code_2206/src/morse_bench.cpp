@@ -0,0 +1,215 @@
+/**
+ * morse_bench - 流式编码/解码的吞吐量测试
+ *
+ * 用法: morse_bench [文本大小 MiB] [临时目录]（默认 1024 MiB、/tmp）
+ *
+ * 先生成指定大小的随机文本（大写字母和数字组成的单词，单词之间一个空格），
+ * 再依次用 transcode 编码、transcode 解码、decodeParallel 解码，
+ * 报告每一步的耗时和吞吐量，并检查两次解码的结果都与原文相同。
+ * 默认大小下编码结果约 3.7 GB；临时文件在结束时删除。
+ */
+
+#include "morse_code.hpp"
+#include "morse_stream.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// 生成文本和比较文件时每次读写的字节数
+constexpr std::size_t BLOCK_SIZE = std::size_t{1} << 20;
+
+// 单词的最大长度
+constexpr int MAX_WORD_LENGTH = 8;
+
+constexpr char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+constexpr std::uint64_t ALPHABET_SIZE = sizeof(ALPHABET) - 1;
+
+bool writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+// 读满 size 字节，到文件末尾时返回实际读到的字节数，出错返回 -1
+ssize_t readFull(int fd, char* data, std::size_t size) {
+    std::size_t total = 0;
+    while (total < size) {
+        const ssize_t got = ::read(fd, data + total, size - total);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (got == 0) break;
+        total += static_cast<std::size_t>(got);
+    }
+    return static_cast<ssize_t>(total);
+}
+
+// 生成 bytes 字节的随机文本，首尾都不是空格；固定种子，每次结果相同
+bool generateText(const std::string& path, std::uint64_t bytes) {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    std::mt19937_64 rng(1);
+    std::vector<char> buffer(BLOCK_SIZE);
+    std::uint64_t bits = 0;
+    int digits = 0;  // bits 中还能取出的 ALPHABET_SIZE 进制位数
+    int word = 1 + static_cast<int>(rng() % MAX_WORD_LENGTH);
+
+    bool ok = true;
+    for (std::uint64_t done = 0; ok && done < bytes;) {
+        const std::size_t size = static_cast<std::size_t>(std::min<std::uint64_t>(BLOCK_SIZE, bytes - done));
+        for (std::size_t i = 0; i < size; ++i) {
+            // 一个 64 位随机数可以取出 12 个字符
+            if (digits == 0) {
+                bits = rng();
+                digits = 12;
+            }
+            const auto digit = static_cast<std::size_t>(bits % ALPHABET_SIZE);
+            bits /= ALPHABET_SIZE;
+            --digits;
+
+            if (word == 0) {
+                buffer[i] = ' ';
+                word = 1 + static_cast<int>(digit % MAX_WORD_LENGTH);
+            } else {
+                buffer[i] = ALPHABET[digit];
+                --word;
+            }
+        }
+        done += size;
+        if (done == bytes && buffer[size - 1] == ' ') {
+            buffer[size - 1] = 'E';
+        }
+        ok = writeAll(fd, buffer.data(), size);
+    }
+    return ::close(fd) == 0 && ok;
+}
+
+// 两个文件的内容是否相同
+bool sameContent(const std::string& a, const std::string& b) {
+    const int fa = ::open(a.c_str(), O_RDONLY);
+    const int fb = ::open(b.c_str(), O_RDONLY);
+    bool same = fa >= 0 && fb >= 0;
+
+    std::vector<char> ba(BLOCK_SIZE);
+    std::vector<char> bb(BLOCK_SIZE);
+    while (same) {
+        const ssize_t na = readFull(fa, ba.data(), BLOCK_SIZE);
+        const ssize_t nb = readFull(fb, bb.data(), BLOCK_SIZE);
+        same = na >= 0 && na == nb && std::memcmp(ba.data(), bb.data(), static_cast<std::size_t>(na)) == 0;
+        if (na == 0) break;
+    }
+
+    if (fa >= 0) ::close(fa);
+    if (fb >= 0) ::close(fb);
+    return same;
+}
+
+using Step = std::function<std::optional<morse::StreamStats>(int, int)>;
+
+// 把 input 转换到 output 并计时，打印一行结果
+bool runStep(const char* name, const std::string& input, const std::string& output, const Step& step) {
+    const int in_fd = ::open(input.c_str(), O_RDONLY);
+    const int out_fd = ::open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (in_fd < 0 || out_fd < 0) {
+        std::fprintf(stderr, "无法打开 %s 或 %s: %s\n", input.c_str(), output.c_str(), std::strerror(errno));
+        if (in_fd >= 0) ::close(in_fd);
+        if (out_fd >= 0) ::close(out_fd);
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto stats = step(in_fd, out_fd);
+    const int error = errno;
+    ::close(in_fd);
+    const bool closed = ::close(out_fd) == 0;
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (!stats || !closed) {
+        std::fprintf(stderr, "%s 读写失败: %s\n", name, std::strerror(stats ? errno : error));
+        return false;
+    }
+    std::printf("%-22s %10.3f %10.3f %9.2f %12.3f %12.3f\n", name, static_cast<double>(stats->bytes_in) / 1e9,
+                static_cast<double>(stats->bytes_out) / 1e9, elapsed.count(),
+                static_cast<double>(stats->bytes_in) / 1e9 / elapsed.count(),
+                static_cast<double>(stats->bytes_out) / 1e9 / elapsed.count());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::uint64_t mebibytes = 1024;
+    if (argc > 1) {
+        const char* end = argv[1] + std::strlen(argv[1]);
+        const auto [ptr, ec] = std::from_chars(argv[1], end, mebibytes);
+        if (argc > 3 || ec != std::errc() || ptr != end || mebibytes == 0 || mebibytes > (1u << 20)) {
+            std::fprintf(stderr, "用法: %s [文本大小 MiB] [临时目录]\n", argv[0]);
+            return 1;
+        }
+    }
+    const std::string dir = argc > 2 ? argv[2] : "/tmp";
+    const std::string prefix = dir + "/morse_bench." + std::to_string(::getpid());
+    const std::string text = prefix + ".txt";
+    const std::string code = prefix + ".morse";
+    const std::string decoded = prefix + ".out";
+
+    const morse::MorseCode mc;
+    std::printf("生成 %llu MiB 随机文本...\n", static_cast<unsigned long long>(mebibytes));
+    bool ok = generateText(text, mebibytes << 20);
+    if (!ok) {
+        std::fprintf(stderr, "无法写入 %s: %s\n", text.c_str(), std::strerror(errno));
+    }
+
+    if (ok) {
+        std::printf("%-22s %10s %10s %9s %12s %12s\n", "Step", "In (GB)", "Out (GB)", "Time (s)", "In (GB/s)",
+                    "Out (GB/s)");
+        ok = runStep("transcode encode", text, code, [&](int in, int out) {
+            return morse::transcode(mc, in, out, morse::Direction::Encode);
+        });
+    }
+    if (ok) {
+        ok = runStep("transcode decode", code, decoded, [&](int in, int out) {
+            return morse::transcode(mc, in, out, morse::Direction::Decode);
+        });
+        if (ok && !sameContent(text, decoded)) {
+            std::fprintf(stderr, "transcode 解码结果与原文不同\n");
+            ok = false;
+        }
+    }
+    if (ok) {
+        ok = runStep("decodeParallel", code, decoded, [&](int in, int out) {
+            return morse::decodeParallel(mc, in, out);
+        });
+        if (ok && !sameContent(text, decoded)) {
+            std::fprintf(stderr, "decodeParallel 解码结果与原文不同\n");
+            ok = false;
+        }
+    }
+
+    ::unlink(text.c_str());
+    ::unlink(code.c_str());
+    ::unlink(decoded.c_str());
+    return ok ? 0 : 1;
+}
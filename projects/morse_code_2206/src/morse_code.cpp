@@ -1,178 +1,288 @@
-#include "morse_code.hpp"
-#include <algorithm>
-#include <cctype>
-#include <sstream>
-
-namespace morse {
-
-MorseCode::MorseCode() {
-    initializeMaps();
-}
-
-void MorseCode::initializeMaps() {
-    // 数字 0-9
-    char_to_morse_['0'] = "-----";
-    char_to_morse_['1'] = ".----";
-    char_to_morse_['2'] = "..---";
-    char_to_morse_['3'] = "...--";
-    char_to_morse_['4'] = "....-";
-    char_to_morse_['5'] = ".....";
-    char_to_morse_['6'] = "-....";
-    char_to_morse_['7'] = "--...";
-    char_to_morse_['8'] = "---..";
-    char_to_morse_['9'] = "----.";
-
-    // 字母 A-Z
-    char_to_morse_['A'] = ".-";
-    char_to_morse_['B'] = "-...";
-    char_to_morse_['C'] = "-.-.";
-    char_to_morse_['D'] = "-..";
-    char_to_morse_['E'] = ".";
-    char_to_morse_['F'] = "..-.";
-    char_to_morse_['G'] = "--.";
-    char_to_morse_['H'] = "....";
-    char_to_morse_['I'] = "..";
-    char_to_morse_['J'] = ".---";
-    char_to_morse_['K'] = "-.-";
-    char_to_morse_['L'] = ".-..";
-    char_to_morse_['M'] = "--";
-    char_to_morse_['N'] = "-.";
-    char_to_morse_['O'] = "---";
-    char_to_morse_['P'] = ".--.";
-    char_to_morse_['Q'] = "--.-";
-    char_to_morse_['R'] = ".-.";
-    char_to_morse_['S'] = "...";
-    char_to_morse_['T'] = "-";
-    char_to_morse_['U'] = "..-";
-    char_to_morse_['V'] = "...-";
-    char_to_morse_['W'] = ".--";
-    char_to_morse_['X'] = "-..-";
-    char_to_morse_['Y'] = "-.--";
-    char_to_morse_['Z'] = "--..";
-
-    // 构建反向映射
-    for (const auto& [ch, code] : char_to_morse_) {
-        morse_to_char_[code] = ch;
-    }
-}
-
-std::string MorseCode::encode(std::string_view text) const {
-    std::ostringstream result;
-    bool first_char_in_word = true;
-    bool prev_was_space = false;
-
-    for (char c : text) {
-        if (c == ' ') {
-            if (!prev_was_space && !first_char_in_word) {
-                result << "   ";  // 单词间三个空格
-            }
-            prev_was_space = true;
-            first_char_in_word = true;
-            continue;
-        }
-
-        prev_was_space = false;
-        char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
-
-        auto it = char_to_morse_.find(upper);
-        if (it != char_to_morse_.end()) {
-            if (!first_char_in_word) {
-                result << ' ';  // 字符间单个空格
-            }
-            result << it->second;
-            first_char_in_word = false;
-        }
-        // 忽略不可编码的字符
-    }
-
-    return result.str();
-}
-
-std::string MorseCode::decode(std::string_view morse) const {
-    std::ostringstream result;
-
-    // 按三个空格分割单词
-    auto words = split(morse, "   ");
-
-    for (size_t i = 0; i < words.size(); ++i) {
-        if (i > 0) {
-            result << ' ';
-        }
-
-        // 按单个空格分割字符
-        auto codes = split(words[i], " ");
-
-        for (const auto& code : codes) {
-            if (code.empty()) continue;
-
-            auto it = morse_to_char_.find(code);
-            if (it != morse_to_char_.end()) {
-                result << it->second;
-            }
-            // 忽略无效的摩尔斯电码
-        }
-    }
-
-    return result.str();
-}
-
-bool MorseCode::isEncodable(char c) const {
-    if (c == ' ') return true;
-    char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
-    return char_to_morse_.find(upper) != char_to_morse_.end();
-}
-
-bool MorseCode::isValidMorse(std::string_view morse) const {
-    if (morse.empty()) return true;
-
-    auto words = split(morse, "   ");
-    for (const auto& word : words) {
-        auto codes = split(word, " ");
-        for (const auto& code : codes) {
-            if (code.empty()) continue;
-            // 检查是否只包含点和划
-            for (char c : code) {
-                if (c != '.' && c != '-') return false;
-            }
-            // 检查是否是有效的摩尔斯电码
-            if (morse_to_char_.find(code) == morse_to_char_.end()) {
-                return false;
-            }
-        }
-    }
-    return true;
-}
-
-std::optional<std::string> MorseCode::charToMorse(char c) const {
-    char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
-
-    if (const auto it = char_to_morse_.find(upper); it != char_to_morse_.end()) {
-        return it->second;
-    }
-    return std::nullopt;
-}
-
-std::optional<char> MorseCode::morseToChar(std::string_view morse) const {
-    if (const auto it = morse_to_char_.find(std::string(morse)); it != morse_to_char_.end()) {
-        return it->second;
-    }
-    return std::nullopt;
-}
-
-std::vector<std::string> MorseCode::split(std::string_view str,
-                                           std::string_view delimiter) const {
-    std::vector<std::string> result;
-    size_t start = 0;
-    size_t end = str.find(delimiter);
-
-    while (end != std::string_view::npos) {
-        result.emplace_back(str.substr(start, end - start));
-        start = end + delimiter.length();
-        end = str.find(delimiter, start);
-    }
-
-    result.emplace_back(str.substr(start));
-    return result;
-}
-
-} // namespace morse
+#include "morse_code.hpp"
+#include "morse_table.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace morse {
+
+namespace {
+
+// 每个可编码字符的输出文本：前导的字符间空格加上点划，补齐到 16 字节，
+// 编码时一次复制 8 字节，再按实际长度前移
+struct Symbols {
+    char text[16];
+};
+
+constexpr std::array<Symbols, 256> makeSymbols() {
+    std::array<Symbols, 256> symbols{};
+    for (std::size_t c = 0; c < 256; ++c) {
+        const std::uint8_t packed = table::ENCODE[c];
+        symbols[c].text[0] = ' ';
+        for (int i = 0; i < table::codeLength(packed); ++i) {
+            symbols[c].text[i + 1] = table::isDash(packed, i) ? '-' : '.';
+        }
+    }
+    return symbols;
+}
+
+constexpr std::array<Symbols, 256> SYMBOLS = makeSymbols();
+
+// 按电码长度和点划位（第 i 位对应第 i 个符号）索引的解码表：
+// 下标为 (1 << 长度) | 点划位，与 table::DECODE 的区别只是符号的位序相反
+constexpr std::array<char, 64> makeDecodeByBits() {
+    std::array<char, 64> decode{};
+    for (const table::Code& c : table::CODES) {
+        const std::uint8_t packed = table::pack(c.code);
+        decode[(1u << table::codeLength(packed)) | (packed & 0x1fu)] = c.ch;
+    }
+    return decode;
+}
+
+constexpr std::array<char, 64> DECODE_BY_BITS = makeDecodeByBits();
+
+#if defined(__SSE2__)
+// 一次分类 64 字节：每个字节是否为空格、点、划，各得到一个 64 位掩码
+struct BlockMasks {
+    std::uint64_t space;
+    std::uint64_t dot;
+    std::uint64_t dash;
+};
+
+inline BlockMasks classifyBlock(const char* p) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i dot = _mm_set1_epi8('.');
+    const __m128i dash = _mm_set1_epi8('-');
+
+    BlockMasks masks{0, 0, 0};
+    for (int part = 0; part < 4; ++part) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + part * 16));
+        const auto bits = [&](const __m128i target) {
+            return static_cast<std::uint64_t>(static_cast<std::uint16_t>(
+                       _mm_movemask_epi8(_mm_cmpeq_epi8(v, target))))
+                   << (part * 16);
+        };
+        masks.space |= bits(space);
+        masks.dot |= bits(dot);
+        masks.dash |= bits(dash);
+    }
+    return masks;
+}
+
+#endif
+
+// 沿解码树走一个字符：点、划之外的字符使整个电码无效
+inline unsigned advance(unsigned node, char c) {
+    const bool dash = c == '-';
+    return dash || c == '.' ? table::step(node, dash) : table::INVALID;
+}
+
+} // namespace
+
+std::string MorseCode::encode(std::string_view text) const {
+    std::string result(maxEncodedSize(text.size()), '\0');
+    result.resize(encodeTo(text, result.data()));
+    return result;
+}
+
+std::string MorseCode::decode(std::string_view morse) const {
+    std::string result(maxDecodedSize(morse.size()), '\0');
+    result.resize(decodeTo(morse, result.data()));
+    return result;
+}
+
+std::size_t MorseCode::encodeTo(std::string_view text, char* out) const {
+    EncodeState state;
+    return encodeChunk(text, state, out);
+}
+
+std::size_t MorseCode::decodeTo(std::string_view morse, char* out) const {
+    DecodeState state;
+    const std::size_t n = decodeChunk(morse, state, out);
+    return n + decodeFinish(state, out + n);
+}
+
+std::size_t MorseCode::encodeChunk(std::string_view text, EncodeState& state, char* out) const {
+    char* p = out;
+    bool in_word = state.in_word;
+    const char* end = text.data() + text.size();
+
+    for (const char* s = text.data(); s != end; ++s) {
+        const auto c = static_cast<unsigned char>(*s);
+
+        if (const std::uint8_t packed = table::ENCODE[c]; packed != 0) {
+            // 单词中的第一个字符不需要前导空格
+            const char* src = SYMBOLS[c].text + (in_word ? 0 : 1);
+            const std::size_t length = static_cast<std::size_t>(table::codeLength(packed)) + in_word;
+
+            // 已写入的字节不超过每个字符 6 字节，所以除最后一个字符外
+            // 剩余空间至少还有 12 字节，可以放心多写
+            if (s + 1 != end) {
+                std::memcpy(p, src, 8);
+            } else {
+                std::memcpy(p, src, length);
+            }
+            p += length;
+            in_word = true;
+        } else if (c == ' ' && in_word) {
+            std::memcpy(p, "   ", 3);  // 单词间三个空格
+            p += 3;
+            in_word = false;
+        }
+        // 忽略不可编码的字符
+    }
+
+    state.in_word = in_word;
+    return static_cast<std::size_t>(p - out);
+}
+
+std::size_t MorseCode::decodeChunk(std::string_view morse, DecodeState& state, char* out) const {
+    char* p = out;
+    const char* s = morse.data();
+    const char* end = s + morse.size();
+
+    unsigned node = state.node;  // 当前电码在解码树中的位置
+    int spaces = state.spaces;   // 连续空格数
+
+    // 逐字节处理一个字节
+    const auto decodeByte = [&](const char c) {
+        if (c == ' ') {
+            // 电码结束：有效则输出对应字符
+            if (const char ch = table::DECODE[node]; ch != '\0') {
+                *p++ = ch;
+            }
+            node = 1;
+
+            if (++spaces == 3) {
+                *p++ = ' ';
+                spaces = 0;
+            }
+        } else {
+            node = advance(node, c);
+            spaces = 0;
+        }
+    };
+
+    // 上一块停在电码或空格段中间：先逐字节处理到下一个电码的开头，
+    // 之前不足三个的空格不再有影响
+    if (node != 1 || spaces != 0) {
+        while (s != end && (node != 1 || *s == ' ')) decodeByte(*s++);
+        if (s != end) spaces = 0;
+    }
+
+#if defined(__SSE2__)
+    const char* last_code = s;  // 上一个电码之后的位置，其后的空格尚未计数
+
+    // 快速路径：每次分类 64 字节，然后只在掩码上取出每个电码的起止位置。
+    // 电码和空格交替出现，逐字节判断时分支几乎每次都预测失败；
+    // 而逐个清除掩码最低位时，各电码之间没有依赖，可以并行执行。
+    // 每块只处理完整的电码，没结束的电码留到下一块从头处理
+    while (end - s >= 64) {
+        const BlockMasks m = classifyBlock(s);
+        const std::uint64_t text = ~m.space;
+        std::uint64_t starts = text & ~(text << 1);  // 电码的第一个字节
+        std::uint64_t ends = m.space & (text << 1);  // 电码之后的第一个空格
+
+        while (ends != 0) {
+            const int first = __builtin_ctzll(starts);
+            const int length = __builtin_ctzll(ends) - first;
+
+            // 电码前的空格：每三个连续空格是一个单词分隔
+            const auto words = (s + first - last_code) / 3;
+            *p = ' ';
+            if (words > 1) std::memset(p, ' ', static_cast<std::size_t>(words));
+            p += words;
+
+            // 长度不超过 5 且只包含点划才有效，无效的电码被忽略
+            const std::uint64_t symbols = (std::uint64_t{1} << length) - 1;
+            const std::uint64_t dashes = m.dash >> first & symbols;
+            const bool valid = ((dashes | (m.dot >> first)) & symbols) == symbols &&
+                               length <= table::MAX_CODE_LENGTH;
+            const char ch = DECODE_BY_BITS[valid ? (1u << length) | dashes : 0];
+            *p = ch;
+            p += ch != '\0';
+
+            last_code = s + first + length;
+            starts &= starts - 1;
+            ends &= ends - 1;
+        }
+
+        if (starts == 0) {
+            s += 64;
+        } else if ((starts & 1) == 0) {
+            s += __builtin_ctzll(starts);  // 从没结束的电码开始下一块
+        } else {
+            // 同一个电码占满整块，一定无效：补上它前面的空格后跳到它后面；
+            // 到输入末尾还没结束时，留给下一块的也是无效电码
+            for (auto words = (s - last_code) / 3; words > 0; --words) *p++ = ' ';
+            while (s != end && *s != ' ') ++s;
+            if (s == end) node = table::INVALID;
+            last_code = s;
+        }
+    }
+
+    // 快速路径结束时位于电码开头或空格段中，先补上已经数过的空格
+    for (auto words = (s - last_code) / 3; words > 0; --words) *p++ = ' ';
+    spaces += static_cast<int>((s - last_code) % 3);
+#endif
+
+    // 剩余部分逐字节处理
+    while (s != end) decodeByte(*s++);
+
+    state.node = node;
+    state.spaces = spaces;
+    return static_cast<std::size_t>(p - out);
+}
+
+std::size_t MorseCode::decodeFinish(DecodeState& state, char* out) const {
+    const char last = table::DECODE[state.node];
+    state = DecodeState{};
+    if (last == '\0') {
+        return 0;
+    }
+    *out = last;
+    return 1;
+}
+
+bool MorseCode::isEncodable(char c) const {
+    return c == ' ' || table::ENCODE[static_cast<unsigned char>(c)] != 0;
+}
+
+bool MorseCode::isValidMorse(std::string_view morse) const {
+    // 每个以空格分隔的电码都必须有效
+    unsigned node = 1;
+    for (const char c : morse) {
+        if (c == ' ') {
+            if (node != 1 && table::DECODE[node] == '\0') return false;
+            node = 1;
+        } else {
+            node = advance(node, c);
+        }
+    }
+    return node == 1 || table::DECODE[node] != '\0';
+}
+
+std::optional<std::string> MorseCode::charToMorse(char c) const {
+    const auto u = static_cast<unsigned char>(c);
+    if (table::ENCODE[u] == 0) {
+        return std::nullopt;
+    }
+    return std::string(SYMBOLS[u].text + 1, static_cast<std::size_t>(table::codeLength(table::ENCODE[u])));
+}
+
+std::optional<char> MorseCode::morseToChar(std::string_view morse) const {
+    unsigned node = 1;
+    for (const char c : morse) {
+        node = advance(node, c);
+    }
+    if (const char ch = table::DECODE[node]; ch != '\0') {
+        return ch;
+    }
+    return std::nullopt;
+}
+
+} // namespace morse
@@ -0,0 +1,76 @@
+#include "morse_parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace morse {
+
+std::size_t nextSplitPoint(std::string_view morse, std::size_t from) {
+    if (from == 0 || from >= morse.size()) {
+        return std::min(from, morse.size());
+    }
+    const bool space = morse[from - 1] == ' ';
+    while (from < morse.size() && (morse[from] == ' ') == space) {
+        ++from;
+    }
+    return from;
+}
+
+std::size_t decodeParallelTo(const MorseCode& mc, std::string_view morse, char* out,
+                             unsigned threads, std::size_t chunk_size) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (chunk_size == 0) {
+        chunk_size = PARALLEL_CHUNK_SIZE;
+    }
+
+    // 块 i 为 [bounds[i], bounds[i + 1])
+    std::vector<std::size_t> bounds{0};
+    while (bounds.back() < morse.size()) {
+        const std::size_t rest = morse.size() - bounds.back();
+        bounds.push_back(rest <= chunk_size ? morse.size()
+                                            : nextSplitPoint(morse, bounds.back() + chunk_size));
+    }
+    const std::size_t chunks = bounds.size() - 1;
+    if (chunks <= 1 || threads == 1) {
+        return mc.decodeTo(morse, out);
+    }
+
+    // 各线程领取块，解码到该块输入所在的位置
+    std::vector<std::size_t> sizes(chunks);
+    std::atomic<std::size_t> next{0};
+    auto worker = [&] {
+        for (std::size_t i = next.fetch_add(1); i < chunks; i = next.fetch_add(1)) {
+            const std::string_view chunk = morse.substr(bounds[i], bounds[i + 1] - bounds[i]);
+            sizes[i] = mc.decodeTo(chunk, out + bounds[i]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned id = 1; id < std::min<std::size_t>(threads, chunks); ++id) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+
+    // 按前缀和前移拼接；目标位置不超过源位置，按顺序移动不会覆盖未移动的结果
+    std::size_t total = sizes[0];
+    for (std::size_t i = 1; i < chunks; ++i) {
+        std::memmove(out + total, out + bounds[i], sizes[i]);
+        total += sizes[i];
+    }
+    return total;
+}
+
+std::string decodeParallel(const MorseCode& mc, std::string_view morse, unsigned threads) {
+    std::string result(MorseCode::maxDecodedSize(morse.size()), '\0');
+    result.resize(decodeParallelTo(mc, morse, result.data(), threads));
+    return result;
+}
+
+} // namespace morse
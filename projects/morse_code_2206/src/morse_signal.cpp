@@ -0,0 +1,410 @@
+#include "morse_signal.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <system_error>
+#include <utility>
+
+namespace morse {
+
+namespace {
+
+// 同时计算的块数：各块的 Goertzel 递推互不依赖，放在一起可以向量化
+constexpr std::size_t LANES = 8;
+
+// 自动检测频率的候选范围、步长和使用的时长
+constexpr double MIN_FREQUENCY = 300;
+constexpr double MAX_FREQUENCY = 1500;
+constexpr double FREQUENCY_STEP = 25;
+constexpr double DETECT_SECONDS = 30;
+
+// 有音调与无音调的能量至少相差 10 dB（对数能量相差 1）
+constexpr double MIN_CONTRAST = 1.0;
+
+// 估计点长时，最短的一类至少要占全部段数的 1/10，否则当作噪声
+constexpr std::size_t MIN_CLUSTER_SHARE = 10;
+
+// 时间估计的修正速度：每个新的点、划或符号间隔占的权重
+constexpr double TIMING_ALPHA = 0.25;
+
+constexpr double PI = 3.14159265358979323846;
+
+std::uint32_t readU32(const unsigned char* p) {
+    return p[0] | p[1] << 8 | p[2] << 16 | static_cast<std::uint32_t>(p[3]) << 24;
+}
+
+std::uint16_t readU16(const unsigned char* p) {
+    return static_cast<std::uint16_t>(p[0] | p[1] << 8);
+}
+
+// 读入整个文件
+std::optional<std::vector<unsigned char>> readFile(const std::string& filename) {
+    // 目录也能用 ifstream 打开，但 tellg() 得不到有意义的大小
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(filename, error)) {
+        return std::nullopt;
+    }
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return std::nullopt;
+    }
+    const std::streamoff size = file.tellg();
+    if (size < 0) {
+        return std::nullopt;
+    }
+    std::vector<unsigned char> data(static_cast<std::size_t>(size));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        return std::nullopt;
+    }
+    return data;
+}
+
+// 一个采样转为 [-1, 1] 的浮点数
+float sampleAt(const unsigned char* p, int bits, bool is_float) {
+    switch (bits) {
+    case 8:
+        return (static_cast<float>(p[0]) - 128.0f) / 128.0f;
+    case 16:
+        return static_cast<float>(static_cast<std::int16_t>(readU16(p))) / 32768.0f;
+    case 24: {
+        // 放到高 24 位后算术右移，完成符号扩展
+        const auto value = static_cast<std::int32_t>(static_cast<std::uint32_t>(p[0]) << 8 |
+                                                     static_cast<std::uint32_t>(p[1]) << 16 |
+                                                     static_cast<std::uint32_t>(p[2]) << 24) >> 8;
+        return static_cast<float>(value) / 8388608.0f;
+    }
+    default:
+        if (is_float) {
+            float value;
+            const std::uint32_t raw = readU32(p);
+            std::memcpy(&value, &raw, sizeof(value));
+            return value;
+        }
+        return static_cast<float>(static_cast<std::int32_t>(readU32(p))) / 2147483648.0f;
+    }
+}
+
+// 对 LANES 个相邻的块同时做 Goertzel 递推，写出每块在目标频率上的能量
+template <std::size_t Lanes>
+void goertzel(const float* x, std::size_t block, float coeff, float* power) {
+    float s1[Lanes] = {};
+    float s2[Lanes] = {};
+    for (std::size_t n = 0; n < block; ++n) {
+        for (std::size_t l = 0; l < Lanes; ++l) {
+            const float s0 = x[l * block + n] + coeff * s1[l] - s2[l];
+            s2[l] = s1[l];
+            s1[l] = s0;
+        }
+    }
+    for (std::size_t l = 0; l < Lanes; ++l) {
+        power[l] = s1[l] * s1[l] + s2[l] * s2[l] - coeff * s1[l] * s2[l];
+    }
+}
+
+// 前 blocks 块在 frequency 上的能量
+std::vector<float> tonePower(const Signal& signal, std::size_t block, std::size_t blocks,
+                             double frequency) {
+    const auto coeff = static_cast<float>(2 * std::cos(2 * PI * frequency / signal.sample_rate));
+    const float* x = signal.samples.data();
+
+    std::vector<float> power(blocks);
+    std::size_t b = 0;
+    for (; b + LANES <= blocks; b += LANES) {
+        goertzel<LANES>(x + b * block, block, coeff, power.data() + b);
+    }
+    for (; b < blocks; ++b) {
+        goertzel<1>(x + b * block, block, coeff, power.data() + b);
+    }
+    return power;
+}
+
+// 在候选频率中找平均能量最大的一个
+double detectFrequency(const Signal& signal, std::size_t block, std::size_t blocks) {
+    const double nyquist = signal.sample_rate / 2.0;
+    const auto detect_blocks = std::min(
+        blocks, static_cast<std::size_t>(DETECT_SECONDS * signal.sample_rate / block) + 1);
+
+    double best = 0;
+    double best_energy = -1;
+    for (double f = MIN_FREQUENCY; f <= MAX_FREQUENCY && f < nyquist; f += FREQUENCY_STEP) {
+        const std::vector<float> power = tonePower(signal, block, detect_blocks, f);
+        const double energy = std::accumulate(power.begin(), power.end(), 0.0);
+        if (energy > best_energy) {
+            best = f;
+            best_energy = energy;
+        }
+    }
+    return best;
+}
+
+// 一维 2-means：返回两类的中心 (低, 高)
+std::pair<double, double> twoMeans(const std::vector<double>& values) {
+    const auto [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+    double low = *min_it;
+    double high = *max_it;
+
+    for (int iteration = 0; iteration < 32; ++iteration) {
+        const double mid = (low + high) / 2;
+        double sums[2] = {0, 0};
+        std::size_t counts[2] = {0, 0};
+        for (const double v : values) {
+            sums[v > mid] += v;
+            counts[v > mid]++;
+        }
+        const double new_low = counts[0] != 0 ? sums[0] / counts[0] : low;
+        const double new_high = counts[1] != 0 ? sums[1] / counts[1] : high;
+        if (new_low == low && new_high == high) {
+            break;
+        }
+        low = new_low;
+        high = new_high;
+    }
+    return {low, high};
+}
+
+// 最短一类长度的平均值：反复二分，直到剩下的长度相差不到一倍。
+// 通常去掉较长的一类；较短的一类太少时认为是噪声造成的碎段，去掉较短的一类
+double shortestCluster(std::vector<double> values) {
+    while (true) {
+        const auto [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+        if (*max_it < 2 * *min_it) {
+            return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+        }
+        const auto [low, high] = twoMeans(values);
+        const double mid = (low + high) / 2;
+        const auto shorter = std::count_if(values.begin(), values.end(), [mid](double v) { return v <= mid; });
+        const bool noise = static_cast<std::size_t>(shorter) * MIN_CLUSTER_SHARE < values.size();
+        values.erase(std::remove_if(values.begin(), values.end(),
+                                    [mid, noise](double v) { return noise ? v <= mid : v > mid; }),
+                     values.end());
+    }
+}
+
+// 3 点中值滤波，去掉只有一块的毛刺；
+// 比较的是滤波前的值（previous 保存上一块的原值），否则改过的一块会把后面相邻的一块也吞掉
+void removeGlitches(std::vector<std::uint8_t>& keys) {
+    if (keys.size() < 3) {
+        return;
+    }
+    std::uint8_t previous = keys[0];
+    for (std::size_t i = 1; i + 1 < keys.size(); ++i) {
+        const std::uint8_t current = keys[i];
+        if (previous == keys[i + 1]) {
+            keys[i] = previous;
+        }
+        previous = current;
+    }
+}
+
+// 连续相同通断状态的一段
+struct Run {
+    bool on;
+    double length;  // 块数
+};
+
+// 从每块的通断状态解码：估计点长，把各段分为点、划和三种间隔
+SignalResult decodeKeys(const MorseCode& mc, std::vector<std::uint8_t> keys, double block_seconds) {
+    SignalResult result;
+    removeGlitches(keys);
+
+    // 去掉开头的静音后分段；结尾的静音只起结束最后一个字符的作用
+    std::vector<Run> runs;
+    std::vector<double> on_lengths;
+    std::vector<double> off_lengths;
+    auto it = std::find(keys.begin(), keys.end(), std::uint8_t{1});
+    while (it != keys.end()) {
+        const auto next = std::find(it, keys.end(), static_cast<std::uint8_t>(!*it));
+        const Run run{*it != 0, static_cast<double>(next - it)};
+        if (next != keys.end()) {
+            (run.on ? on_lengths : off_lengths).push_back(run.length);
+        } else if (run.on) {
+            on_lengths.push_back(run.length);
+        }
+        runs.push_back(run);
+        it = next;
+    }
+    if (on_lengths.empty()) {
+        return result;
+    }
+
+    // 初始点长：点与符号内间隔都是一个单位，取两者中最短的一类
+    double dot = shortestCluster(on_lengths);
+    if (!off_lengths.empty()) {
+        dot = std::min(dot, shortestCluster(off_lengths));
+    }
+
+    std::string symbols;
+    double dot_sum = 0;
+    const auto flush = [&] {
+        if (symbols.empty()) return;
+        if (const auto ch = mc.morseToChar(symbols)) {
+            result.text += *ch;
+        }
+        symbols.clear();
+    };
+
+    for (const Run& run : runs) {
+        if (run.on) {
+            // 长于两个单位为划，用本段修正点长
+            const bool dash = run.length > 2 * dot;
+            symbols += dash ? '-' : '.';
+            dot += TIMING_ALPHA * ((dash ? run.length / 3 : run.length) - dot);
+            dot_sum += dot;
+        } else if (run.length < 2 * dot) {
+            // 符号内间隔（1 个单位）
+            dot += TIMING_ALPHA * (run.length - dot);
+        } else {
+            // 字符间隔（3 个单位）或单词间隔（7 个单位）
+            flush();
+            if (run.length >= 5 * dot && !result.text.empty() && result.text.back() != ' ') {
+                result.text += ' ';
+            }
+        }
+    }
+    flush();
+
+    if (!result.text.empty() && result.text.back() == ' ') {
+        result.text.pop_back();
+    }
+    // 标准单词 PARIS 为 50 个单位
+    result.wpm = 60.0 / (50 * dot_sum / on_lengths.size() * block_seconds);
+    return result;
+}
+
+std::size_t blockSize(const Signal& signal, const SignalOptions& options) {
+    return std::max<std::size_t>(1, static_cast<std::size_t>(
+                                        std::lround(signal.sample_rate * options.block_ms / 1000)));
+}
+
+} // namespace
+
+std::optional<Signal> readWav(const std::string& filename) {
+    const auto file = readFile(filename);
+    if (!file || file->size() < 12) {
+        return std::nullopt;
+    }
+    const unsigned char* data = file->data();
+    const std::size_t size = file->size();
+    if (std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) {
+        return std::nullopt;
+    }
+
+    unsigned format = 0;
+    unsigned channels = 0;
+    unsigned sample_rate = 0;
+    unsigned bits = 0;
+
+    // 依次查找 fmt 和 data 块，其他块跳过（块长度为奇数时补齐到偶数）
+    for (std::size_t pos = 12; pos + 8 <= size;) {
+        const unsigned char* chunk = data + pos;
+        const std::size_t length = std::min<std::size_t>(readU32(chunk + 4), size - pos - 8);
+        const unsigned char* body = chunk + 8;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && length >= 16) {
+            format = readU16(body);
+            channels = readU16(body + 2);
+            sample_rate = readU32(body + 4);
+            bits = readU16(body + 14);
+            if (format == 0xfffe && length >= 26) {
+                format = readU16(body + 24);  // WAVE_FORMAT_EXTENSIBLE 的子格式
+            }
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            const bool is_float = format == 3;
+            const bool supported = (format == 1 && (bits == 8 || bits == 16 || bits == 24 || bits == 32)) ||
+                                   (is_float && bits == 32);
+            if (!supported || channels == 0 || sample_rate == 0) {
+                return std::nullopt;
+            }
+
+            const std::size_t sample_bytes = bits / 8;
+            const std::size_t frames = length / (sample_bytes * channels);
+            Signal signal;
+            signal.sample_rate = sample_rate;
+            signal.samples.resize(frames);
+            for (std::size_t i = 0; i < frames; ++i) {
+                const unsigned char* frame = body + i * sample_bytes * channels;
+                float sum = 0;
+                for (unsigned c = 0; c < channels; ++c) {
+                    sum += sampleAt(frame + c * sample_bytes, static_cast<int>(bits), is_float);
+                }
+                signal.samples[i] = sum / static_cast<float>(channels);
+            }
+            return signal;
+        }
+        pos += 8 + length + (length & 1);
+    }
+    return std::nullopt;
+}
+
+std::optional<Signal> readKeying(const std::string& filename, unsigned sample_rate) {
+    const auto file = readFile(filename);
+    if (!file || sample_rate == 0) {
+        return std::nullopt;
+    }
+
+    Signal signal;
+    signal.sample_rate = sample_rate;
+    signal.samples.reserve(file->size());
+    for (const unsigned char c : *file) {
+        if (c == '1' || c == 1) {
+            signal.samples.push_back(1.0f);
+        } else if (c == '0' || c == 0) {
+            signal.samples.push_back(0.0f);
+        }
+    }
+    return signal;
+}
+
+SignalResult decodeTone(const MorseCode& mc, const Signal& signal, const SignalOptions& options) {
+    const std::size_t block = blockSize(signal, options);
+    const std::size_t blocks = signal.samples.size() / block;
+    if (blocks == 0) {
+        return {};
+    }
+
+    const double frequency = options.frequency > 0 ? options.frequency
+                                                   : detectFrequency(signal, block, blocks);
+    const std::vector<float> power = tonePower(signal, block, blocks, frequency);
+
+    // 相邻三块的能量取平均以降低噪声，取对数后分成两类，以两类中心的中点为阈值
+    std::vector<double> levels(blocks);
+    for (std::size_t b = 0; b < blocks; ++b) {
+        const std::size_t first = b == 0 ? 0 : b - 1;
+        const std::size_t last = std::min(b + 2, blocks);
+        const double mean = std::accumulate(power.begin() + first, power.begin() + last, 0.0) / (last - first);
+        levels[b] = std::log10(mean + 1e-12);
+    }
+    const auto [low, high] = twoMeans(levels);
+    if (high - low < MIN_CONTRAST) {
+        return {"", frequency, 0};  // 两类相差太小，只有噪声
+    }
+    const double threshold = (low + high) / 2;
+
+    std::vector<std::uint8_t> keys(blocks);
+    std::transform(levels.begin(), levels.end(), keys.begin(),
+                   [threshold](double level) { return level > threshold; });
+
+    SignalResult result = decodeKeys(mc, std::move(keys), static_cast<double>(block) / signal.sample_rate);
+    result.frequency = frequency;
+    return result;
+}
+
+SignalResult decodeKeying(const MorseCode& mc, const Signal& signal, const SignalOptions& options) {
+    const std::size_t block = blockSize(signal, options);
+    const std::size_t blocks = signal.samples.size() / block;
+
+    // 块内过半的采样为按下则整块为按下
+    std::vector<std::uint8_t> keys(blocks);
+    for (std::size_t b = 0; b < blocks; ++b) {
+        const float* x = signal.samples.data() + b * block;
+        keys[b] = std::accumulate(x, x + block, 0.0f) > 0.5f * static_cast<float>(block);
+    }
+    return decodeKeys(mc, std::move(keys), static_cast<double>(block) / signal.sample_rate);
+}
+
+} // namespace morse
@@ -0,0 +1,133 @@
+#include "morse_stream.hpp"
+#include "morse_parallel.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace morse {
+
+namespace {
+
+// 读满 size 字节或读到输入结束，返回读到的字节数；出错返回 -1
+ssize_t readChunk(int fd, char* buffer, std::size_t size) {
+    std::size_t got = 0;
+    while (got < size) {
+        const ssize_t n = ::read(fd, buffer + got, size - got);
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        got += static_cast<std::size_t>(n);
+    }
+    return static_cast<ssize_t>(got);
+}
+
+// 写出全部 size 字节
+bool writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        const ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+std::optional<StreamStats> transcode(const MorseCode& mc, int in_fd, int out_fd,
+                                     Direction direction, std::size_t chunk_size) {
+    if (chunk_size == 0) chunk_size = DEFAULT_CHUNK_SIZE;
+
+    // 解码结束时还可能多输出 1 字节
+    const std::size_t out_size = direction == Direction::Encode
+                                     ? MorseCode::maxEncodedSize(chunk_size)
+                                     : MorseCode::maxDecodedSize(chunk_size) + 1;
+    const std::unique_ptr<char[]> in(new char[chunk_size]);
+    const std::unique_ptr<char[]> out(new char[out_size]);
+
+    MorseCode::EncodeState encode_state;
+    MorseCode::DecodeState decode_state;
+    StreamStats stats;
+
+    while (true) {
+        const ssize_t got = readChunk(in_fd, in.get(), chunk_size);
+        if (got < 0) return std::nullopt;
+
+        const std::string_view chunk(in.get(), static_cast<std::size_t>(got));
+        std::size_t written = direction == Direction::Encode
+                                  ? mc.encodeChunk(chunk, encode_state, out.get())
+                                  : mc.decodeChunk(chunk, decode_state, out.get());
+
+        // 输入结束：解码时补上最后一个电码
+        const bool done = static_cast<std::size_t>(got) < chunk_size;
+        if (done && direction == Direction::Decode) {
+            written += mc.decodeFinish(decode_state, out.get() + written);
+        }
+
+        if (!writeAll(out_fd, out.get(), written)) return std::nullopt;
+        stats.bytes_in += static_cast<std::uint64_t>(got);
+        stats.bytes_out += written;
+
+        if (done) return stats;
+    }
+}
+
+std::optional<StreamStats> decodeParallel(const MorseCode& mc, int in_fd, int out_fd,
+                                          unsigned threads) {
+    struct stat st {};
+    if (::fstat(in_fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        return transcode(mc, in_fd, out_fd, Direction::Decode);
+    }
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, in_fd, 0);
+    if (map == MAP_FAILED) {
+        return transcode(mc, in_fd, out_fd, Direction::Decode);
+    }
+    ::madvise(map, size, MADV_SEQUENTIAL);
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // 每个窗口给每个线程几块，窗口之间串行写出，内存占用与文件大小无关
+    const std::string_view morse(static_cast<const char*>(map), size);
+    const std::size_t window = PARALLEL_CHUNK_SIZE * 4 * threads;
+    std::vector<char> out;
+    StreamStats stats;
+
+    for (std::size_t begin = 0; begin < size;) {
+        const std::size_t end = size - begin <= window ? size : nextSplitPoint(morse, begin + window);
+        const std::string_view part = morse.substr(begin, end - begin);
+        if (out.size() < MorseCode::maxDecodedSize(part.size())) {
+            out.resize(MorseCode::maxDecodedSize(part.size()));
+        }
+
+        const std::size_t written = decodeParallelTo(mc, part, out.data(), threads);
+        if (!writeAll(out_fd, out.data(), written)) {
+            const int error = errno;
+            ::munmap(map, size);
+            errno = error;
+            return std::nullopt;
+        }
+        stats.bytes_in += part.size();
+        stats.bytes_out += written;
+        begin = end;
+    }
+
+    ::munmap(map, size);
+    return stats;
+}
+
+} // namespace morse
@@ -12,4 +12,7 @@ constexpr int FINISH_LINE = 70;
 /// 起点位置（第1格）
 constexpr int START_LINE = 1;
 
+/// 每次移动的随机数范围为 1 到 ROLL_SIDES
+constexpr int ROLL_SIDES = 10;
+
 #endif // CONSTANTS_H
@@ -21,12 +21,15 @@
  */
 class Hare final : public Racer {
 public:
+    /// 移动规则表（按随机数1-10索引），供 move() 和无界面的模拟共用
+    static constexpr MoveTable MOVES = {0, 0, 9, 9, -12, 1, 1, 1, -2, -2};
+
     /// 构造函数，初始化名称为"Hare"，符号为'H'
     Hare();
 
     /**
      * @brief 实现兔子的移动规则
-     * @details 使用switch语句清晰表达五种不同的移动类型
+     * @details 根据随机数查移动规则表：睡觉、大跳、严重滑倒、小跳或轻微滑倒
      */
     void move() override;
 };
@@ -0,0 +1,105 @@
+/**
+ * @file MassRace.h
+ * @brief 大量参赛者同场比赛的类声明（运行时决定人数）
+ */
+
+#ifndef MASS_RACE_H
+#define MASS_RACE_H
+
+#include "Constants.h"
+#include "Racer.h"
+#include "Xoshiro256.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @struct MassRaceResult
+ * @brief 一场大规模比赛的结果
+ */
+struct MassRaceResult {
+    int ticks{0};                       ///< 比赛用的滴答数
+    std::vector<std::size_t> winners;   ///< 同一滴答到达终点的参赛者编号，为空表示超过滴答上限仍未结束
+};
+
+/**
+ * @class MassRace
+ * @brief 数千名参赛者同场比赛，不创建参赛者对象，也不输出赛道
+ * @details
+ * 参赛者的状态按结构数组（SoA）存放：所有人的位置是一个数组，移动规则表
+ * 按随机数拆成 ROLL_SIDES 个数组（第 k 个数组存放每个人掷出 k + 1 时的位移，
+ * 用 int8_t 存放，一条向量指令可以处理 16 个人）。
+ * 一个滴答里每 CHUNK 名参赛者为一段：先由 Xoshiro256Lanes 生成每人的点数，
+ * 再逐个规则数组用掩码选出每人的位移，最后统一更新位置。
+ * 各步都是对连续数组做同样的运算，没有虚函数调用和查表，编译器可以向量化。
+ * 人数按 BLOCK 向上补齐，补上的参赛者位移全为零，永远停在起点。
+ */
+class MassRace {
+public:
+    /// 并行的随机数序列条数
+    static constexpr std::size_t LANES = 8;
+
+    /// 每组参赛者人数：每个 64 位随机数的高低两半各给一名参赛者
+    static constexpr std::size_t BLOCK = 2 * LANES;
+
+    /// tick() 每次处理的参赛者人数，临时数组放得进一级缓存
+    static constexpr std::size_t CHUNK = 64 * BLOCK;
+
+    /// run() 默认的滴答上限，防止没有人能到达终点时无限循环
+    static constexpr int DEFAULT_MAX_TICKS = 1'000'000;
+
+    /// 命令行接受的最大参赛者人数（约 1 GB 内存）
+    static constexpr std::size_t MAX_RACERS = 100'000'000;
+
+    /**
+     * @brief 构造函数
+     * @param seed 随机数种子，同样的种子和参赛者得到同样的比赛
+     */
+    explicit MassRace(std::uint64_t seed) noexcept;
+
+    /**
+     * @brief 添加一名参赛者，位置为起点
+     * @param moves 移动规则表
+     * @return 参赛者编号（从0开始）
+     * @throws std::invalid_argument 位移超出 int8_t 的范围
+     */
+    std::size_t addRacer(const MoveTable& moves);
+
+    /**
+     * @brief 预先为 racers 名参赛者分配空间
+     * @throws std::bad_alloc 内存不足（在添加参赛者之前就能发现）
+     */
+    void reserve(std::size_t racers);
+
+    /// 参赛者人数（不含补齐的部分）
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /// 所有参赛者的当前位置，按编号排列
+    [[nodiscard]] std::span<const int> getPositions() const noexcept;
+
+    /// 所有参赛者回到起点
+    void reset() noexcept;
+
+    /// 一个时钟滴答：所有参赛者各掷一次并移动
+    void tick() noexcept;
+
+    /// 是否有参赛者到达终点
+    [[nodiscard]] bool hasFinished() const noexcept;
+
+    /**
+     * @brief 从当前位置开始比赛，直到有人到达终点
+     * @param maxTicks 滴答上限
+     * @return 比赛结果
+     */
+    MassRaceResult run(int maxTicks = DEFAULT_MAX_TICKS);
+
+private:
+    std::size_t count{0};                                   ///< 参赛者人数
+    std::vector<int> positions;                             ///< 各参赛者的位置（长度为 BLOCK 的倍数）
+    std::array<std::vector<std::int8_t>, ROLL_SIDES> moves; ///< moves[k][i]：参赛者 i 掷出 k + 1 时的位移
+    Xoshiro256Lanes<LANES> rng;                             ///< 并行的随机数序列
+};
+
+#endif // MASS_RACE_H
@@ -8,41 +8,70 @@
 
 #include "RacerConcept.h"
 #include "Constants.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <iostream>
-#include <memory>
+#include <iterator>
 #include <format>
 #include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
 
 /**
  * @class Race
  * @brief 比赛管理类，负责协调整个赛跑过程
- * @tparam R1 参赛者1的类型（必须满足RacerConcept）
- * @tparam R2 参赛者2的类型（必须满足RacerConcept）
- * @details 使用C++20模板和概念确保类型安全，支持任意满足RacerConcept的参赛者类型
+ * @tparam Rs 各参赛者的类型（必须满足RacerConcept），个数不限
+ * @details
+ * 参赛者按值保存在 std::tuple 中，用折叠表达式依次调用，编译期即确定
+ * 调用的函数（静态分派）：Tortoise、Hare 这样的 final 类即使继承了虚函数
+ * move()，调用也会被直接内联，不经过虚函数表。
+ * 参赛者的顺序就是移动的顺序，两名参赛者时的输出与原来的 Race<R1, R2> 相同。
  */
-template<RacerConcept R1, RacerConcept R2>
+template<RacerConcept... Rs>
 class Race {
+    static_assert(sizeof...(Rs) >= 1, "比赛至少需要一名参赛者");
+
+public:
+    /// 参赛者人数
+    static constexpr std::size_t RACER_COUNT = sizeof...(Rs);
+
 private:
-    std::unique_ptr<R1> racer1;     ///< 参赛者1的智能指针
-    std::unique_ptr<R2> racer2;     ///< 参赛者2的智能指针
-    int tickCount{0};                ///< 时钟滴答计数（比赛回合数）
-
-    /// 获胜者枚举类型，使用enum class提高类型安全性
-    enum class Winner {
-        None,       ///< 尚未决出胜负
-        Racer1,     ///< 参赛者1获胜
-        Racer2,     ///< 参赛者2获胜
-        Tie         ///< 平局
-    };
+    std::tuple<Rs...> racers;       ///< 所有参赛者（按值保存）
+    int tickCount{0};               ///< 时钟滴答计数（比赛回合数）
+    std::string frame;              ///< 帧缓冲区，每个滴答复用
+
+    /// 一帧的最大长度："Tick N: "、"OUCH!!! " 和每格最多 7 个字符
+    static constexpr std::size_t MAX_FRAME_SIZE = 32 + 8 + 7 * FINISH_LINE + 1;
+
+    /// 每名参赛者是否到达终点，全为false表示尚未决出胜负
+    using Finishers = std::array<bool, RACER_COUNT>;
+
+    /// 依次取出每名参赛者的某项属性
+    template<typename T, typename F>
+    [[nodiscard]] std::array<T, RACER_COUNT> collect(F&& get) const {
+        return std::apply([&](const auto&... racer) { return std::array<T, RACER_COUNT>{get(racer)...}; },
+                          racers);
+    }
+
+    [[nodiscard]] std::array<int, RACER_COUNT> positions() const {
+        return collect<int>([](const auto& racer) { return static_cast<int>(racer.getPosition()); });
+    }
+
+    [[nodiscard]] std::array<std::string_view, RACER_COUNT> names() const {
+        return collect<std::string_view>([](const auto& racer) { return std::string_view(racer.getName()); });
+    }
 
 public:
     /**
      * @brief 构造函数
-     * @param r1 参赛者1的unique_ptr
-     * @param r2 参赛者2的unique_ptr
+     * @param rs 各参赛者（移动进比赛对象）
      */
-    Race(std::unique_ptr<R1> r1, std::unique_ptr<R2> r2)
-        : racer1(std::move(r1)), racer2(std::move(r2)) {}
+    explicit Race(Rs... rs) : racers(std::move(rs)...) {
+        frame.reserve(MAX_FRAME_SIZE);
+    }
 
     /**
      * @brief 打印比赛开始信息
@@ -53,84 +82,96 @@ public:
     }
 
     /**
-     * @brief 打印当前赛道状态
-     * @details 使用C++20 ranges库的iota视图遍历赛道，显示参赛者位置
-     *          如果两个参赛者在同一位置，则显示"OUCH!!!"
+     * @brief 把当前赛道状态追加到 out
+     * @details 先在格子数组中标出参赛者，再整段追加；
+     *          如果有参赛者在同一位置，行首显示"OUCH!!! "，相遇的格子显示"OUCH!!!"
      */
-    void printTrack() const {
-        const int pos1 = racer1->getPosition();
-        const int pos2 = racer2->getPosition();
-
-        if (pos1 == pos2) {
-            // 两者在同一位置
-            std::cout << "OUCH!!! ";
-            for (const int i : std::views::iota(1, FINISH_LINE + 1)) {
-                std::cout << (i == pos1 ? "OUCH!!!" : " ");
+    void renderTrack(std::string& out) const {
+        const auto pos = positions();
+        const auto symbols = collect<char>([](const auto& racer) { return static_cast<char>(racer.getSymbol()); });
+
+        std::array<char, FINISH_LINE + 1> cells;
+        std::array<int, FINISH_LINE + 1> counts{};
+        cells.fill(' ');
+
+        bool collision = false;
+        for (std::size_t i = 0; i < RACER_COUNT; ++i) {
+            for (std::size_t j = i + 1; j < RACER_COUNT; ++j) {
+                collision = collision || pos[i] == pos[j];
             }
-        } else {
-            // 两者在不同位置，正常显示
-            for (const int i : std::views::iota(1, FINISH_LINE + 1)) {
-                if (i == pos1) {
-                    std::cout << racer1->getSymbol();
-                } else if (i == pos2) {
-                    std::cout << racer2->getSymbol();
-                } else {
-                    std::cout << ' ';
-                }
+            if (pos[i] >= 1 && pos[i] <= FINISH_LINE) {
+                const auto cell = static_cast<std::size_t>(pos[i]);
+                cells[cell] = symbols[i];
+                ++counts[cell];
+            }
+        }
+
+        if (!collision) {
+            out.append(cells.data() + 1, FINISH_LINE);
+            return;
+        }
+        out += "OUCH!!! ";
+        for (const int i : std::views::iota(1, FINISH_LINE + 1)) {
+            const auto cell = static_cast<std::size_t>(i);
+            if (counts[cell] > 1) {
+                out += "OUCH!!!";
+            } else {
+                out += cells[cell];
             }
         }
-        std::cout << '\n';
     }
 
     /**
-     * @brief 检查比赛是否结束并返回获胜者
-     * @return Winner枚举值，表示获胜情况
+     * @brief 打印当前滴答的一帧
+     * @details 整行先写入预先分配的帧缓冲区，再用一次 write 输出
      */
-    [[nodiscard]] Winner checkWinner() const noexcept {
-        const bool r1Finished = racer1->hasFinished();
-        const bool r2Finished = racer2->hasFinished();
-
-        if (r1Finished && r2Finished) {
-            return Winner::Tie;         // 同时到达，平局
-        } else if (r1Finished) {
-            return Winner::Racer1;      // 参赛者1先到达
-        } else if (r2Finished) {
-            return Winner::Racer2;      // 参赛者2先到达
-        }
-        return Winner::None;            // 比赛继续
+    void printFrame() {
+        frame.clear();
+        std::format_to(std::back_inserter(frame), "Tick {}: ", tickCount);
+        renderTrack(frame);
+        frame += '\n';
+        std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+    }
+
+    /**
+     * @brief 检查比赛是否结束
+     * @return 每名参赛者是否已到达终点
+     */
+    [[nodiscard]] Finishers checkWinner() const noexcept {
+        return collect<bool>([](const auto& racer) { return static_cast<bool>(racer.hasFinished()); });
     }
 
     /**
      * @brief 打印获胜信息
-     * @param winner 获胜者枚举值
-     * @details 根据不同的参赛者显示特定的获胜消息
+     * @param finishers 每名参赛者是否到达终点
+     * @details 根据不同的参赛者显示特定的获胜消息；多人同时到达为平局
      */
-    void printWinnerMessage(Winner winner) const {
+    void printWinnerMessage(const Finishers& finishers) const {
         std::cout << '\n';
 
-        switch (winner) {
-            case Winner::Racer1:
-                // 参赛者1获胜
-                if (racer1->getName() == "Tortoise") {
-                    std::cout << "TORTOISE WINS!!! YAY!!!\n";  // 乌龟获胜！
-                } else {
-                    std::cout << std::format("{} wins!\n", racer1->getName());
-                }
-                break;
-            case Winner::Racer2:
-                // 参赛者2获胜
-                if (racer2->getName() == "Hare") {
-                    std::cout << "Hare wins. Yuch.\n";  // 兔子获胜
-                } else {
-                    std::cout << std::format("{} wins!\n", racer2->getName());
-                }
-                break;
-            case Winner::Tie:
-                // 平局
-                std::cout << "It's a tie.\n";
-                break;
-            case Winner::None:
-                break;
+        const auto all = names();
+        auto winners = std::views::iota(std::size_t{0}, RACER_COUNT)
+                           | std::views::filter([&](std::size_t i) { return finishers[i]; });
+        const auto count = std::ranges::distance(winners);
+
+        if (count == 1) {
+            const std::string_view winner = all[*winners.begin()];
+            if (winner == "Tortoise") {
+                std::cout << "TORTOISE WINS!!! YAY!!!\n";  // 乌龟获胜！
+            } else if (winner == "Hare") {
+                std::cout << "Hare wins. Yuch.\n";  // 兔子获胜
+            } else {
+                std::cout << std::format("{} wins!\n", winner);
+            }
+        } else if (count == static_cast<std::ptrdiff_t>(RACER_COUNT)) {
+            std::cout << "It's a tie.\n";  // 全部同时到达
+        } else if (count > 1) {
+            std::string list;
+            for (const std::size_t i : winners) {
+                list += list.empty() ? "" : ", ";
+                list += all[i];
+            }
+            std::cout << std::format("It's a tie between {}.\n", list);
         }
     }
 
@@ -139,34 +180,44 @@ public:
      * @details 使用C++20的std::format格式化输出
      */
     void printStatistics() const {
+        const auto all = names();
+        const auto pos = positions();
+
+        std::string list;
+        for (std::size_t i = 0; i < RACER_COUNT; ++i) {
+            list += std::format("{}{}: {}", i == 0 ? "" : ", ", all[i], pos[i]);
+        }
+
         std::cout << std::format("\nRace finished in {} ticks!\n", tickCount);
-        std::cout << std::format("Final positions - {}: {}, {}: {}\n",
-                                 racer1->getName(), racer1->getPosition(),
-                                 racer2->getName(), racer2->getPosition());
+        std::cout << std::format("Final positions - {}\n", list);
     }
 
     /**
      * @brief 运行整场比赛
+     * @param renderEvery 每隔多少个滴答显示一帧赛道，最后一个滴答总是显示
      * @details 主循环：每个时钟滴答移动参赛者，显示赛道，检查获胜条件
      */
-    void run() {
+    void run(int renderEvery = 1) {
+        renderEvery = std::max(renderEvery, 1);
         printStartMessage();
 
         while (true) {
             ++tickCount;  // 时钟滴答
 
-            // 移动两个参赛者
-            racer1->move();
-            racer2->move();
+            // 按顺序移动所有参赛者
+            std::apply([](auto&... racer) { (racer.move(), ...); }, racers);
+
+            // 检查是否有获胜者
+            const Finishers finishers = checkWinner();
+            const bool finished = std::ranges::find(finishers, true) != finishers.end();
 
             // 显示当前赛道状态
-            std::cout << std::format("Tick {}: ", tickCount);
-            printTrack();
+            if (finished || tickCount % renderEvery == 0) {
+                printFrame();
+            }
 
-            // 检查是否有获胜者
-            const Winner winner = checkWinner();
-            if (winner != Winner::None) {
-                printWinnerMessage(winner);
+            if (finished) {
+                printWinnerMessage(finishers);
                 break;  // 比赛结束
             }
         }
@@ -0,0 +1,79 @@
+/**
+ * @file RaceSimulator.h
+ * @brief 无界面的蒙特卡洛比赛模拟器声明
+ */
+
+#ifndef RACE_SIMULATOR_H
+#define RACE_SIMULATOR_H
+
+#include "Constants.h"
+#include "Racer.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class Xoshiro256;
+
+/**
+ * @struct SimulationResult
+ * @brief 大量比赛的统计结果
+ */
+struct SimulationResult {
+    std::uint64_t races{0};         ///< 比赛场数
+    std::uint64_t racer1Wins{0};    ///< 参赛者1获胜场数
+    std::uint64_t racer2Wins{0};    ///< 参赛者2获胜场数
+    std::uint64_t ties{0};          ///< 平局场数
+    std::uint64_t totalTicks{0};    ///< 所有比赛的滴答数之和
+
+    /// 滴答数直方图：第 t 项为 t 个滴答结束的场数，最后一项包含所有更长的比赛
+    std::vector<std::uint64_t> tickHistogram;
+
+    /// 平均每场比赛的滴答数
+    [[nodiscard]] double meanTicks() const noexcept;
+
+    /// 合并另一部分的统计结果
+    void merge(const SimulationResult& other);
+};
+
+/**
+ * @class RaceSimulator
+ * @brief 按移动规则表直接模拟比赛，不创建参赛者对象，也不输出赛道
+ * @details
+ * 每个线程使用自己的 xoshiro256** 随机数序列：从同一个种子出发，
+ * 第 i 个线程的序列向前跳 i 次 2^128 步，各序列互不重叠。
+ * 比赛按线程平均分配，同样的种子和线程数得到同样的结果。
+ */
+class RaceSimulator {
+public:
+    /// 直方图记录的最大滴答数
+    static constexpr int MAX_HISTOGRAM_TICKS = 1000;
+
+    /// 命令行接受的最大线程数
+    static constexpr unsigned MAX_THREADS = 1024;
+
+    /**
+     * @brief 构造函数
+     * @param racer1Moves 参赛者1的移动规则表
+     * @param racer2Moves 参赛者2的移动规则表
+     */
+    RaceSimulator(const MoveTable& racer1Moves, const MoveTable& racer2Moves) noexcept;
+
+    /**
+     * @brief 模拟多场比赛
+     * @param races 比赛场数
+     * @param seed 随机数种子
+     * @param threads 线程数，为0时使用全部硬件线程；超过比赛场数时按场数计
+     * @return 统计结果
+     */
+    [[nodiscard]] SimulationResult run(std::uint64_t races, std::uint64_t seed, unsigned threads = 0) const;
+
+private:
+    /// 一个滴答内两个参赛者的位移，按 (随机数1 - 1) * ROLL_SIDES + (随机数2 - 1) 索引
+    std::array<int, ROLL_SIDES * ROLL_SIDES> moves1{};
+    std::array<int, ROLL_SIDES * ROLL_SIDES> moves2{};
+
+    /// 用一条随机数序列模拟 races 场比赛，结果累加到 result
+    void simulate(std::uint64_t races, Xoshiro256& rng, SimulationResult& result) const;
+};
+
+#endif // RACE_SIMULATOR_H
@@ -0,0 +1,68 @@
+/**
+ * @file RaceSolver.h
+ * @brief 按马尔可夫链精确计算比赛结果概率的求解器声明
+ */
+
+#ifndef RACE_SOLVER_H
+#define RACE_SOLVER_H
+
+#include "Constants.h"
+#include "Racer.h"
+#include <array>
+#include <vector>
+
+/**
+ * @struct ExactResult
+ * @brief 比赛结果的精确概率
+ */
+struct ExactResult {
+    double racer1Wins{0};           ///< 参赛者1获胜的概率
+    double racer2Wins{0};           ///< 参赛者2获胜的概率
+    double ties{0};                 ///< 平局的概率
+    double meanTicks{0};            ///< 比赛滴答数的期望
+    double tickVariance{0};         ///< 比赛滴答数的方差
+    double unresolved{0};           ///< 计算停止时比赛仍未结束的概率（截断误差的上界）
+
+    /// 滴答数分布：第 t 项为比赛恰好在第 t 个滴答结束的概率
+    std::vector<double> tickDistribution;
+};
+
+/**
+ * @class RaceSolver
+ * @brief 用动态规划精确计算比赛结果的概率，用来代替和检验蒙特卡洛模拟
+ * @details
+ * 参赛者的位置是一条马尔可夫链：每个滴答按移动规则表等概率地转移，
+ * 到达终点后吸收。两名参赛者的移动互不影响，所以两人位置的联合分布
+ * 就是各自分布的乘积，只需逐个滴答推进两个 FINISH_LINE 格的分布，
+ * 再由两人"恰好在第 t 个滴答到达"和"第 t 个滴答后仍未到达"的概率
+ * 组合出胜负和比赛长度，不必推进 FINISH_LINE^2 个状态的联合分布。
+ * 未结束的概率低于给定的容差后停止，结果的误差不超过 unresolved。
+ */
+class RaceSolver {
+public:
+    /// 默认容差：未结束的概率低于此值时停止
+    static constexpr double DEFAULT_TOLERANCE = 1e-15;
+
+    /// 最多推进的滴答数（参赛者可能永远到不了终点）
+    static constexpr int MAX_TICKS = 1'000'000;
+
+    /**
+     * @brief 构造函数
+     * @param racer1Moves 参赛者1的移动规则表
+     * @param racer2Moves 参赛者2的移动规则表
+     */
+    RaceSolver(const MoveTable& racer1Moves, const MoveTable& racer2Moves) noexcept;
+
+    /**
+     * @brief 计算比赛结果的概率
+     * @param tolerance 容差
+     * @return 精确结果
+     */
+    [[nodiscard]] ExactResult solve(double tolerance = DEFAULT_TOLERANCE) const;
+
+private:
+    MoveTable moves1;
+    MoveTable moves2;
+};
+
+#endif // RACE_SOLVER_H
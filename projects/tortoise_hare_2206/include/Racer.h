@@ -7,9 +7,13 @@
 #define RACER_H
 
 #include "Constants.h"
+#include <array>
 #include <string>
 #include <string_view>
 
+/// 移动规则表：第 i 项为随机数 i + 1 对应的位移（正数向右，负数向左）
+using MoveTable = std::array<int, ROLL_SIDES>;
+
 /**
  * @class Racer
  * @brief 参赛者抽象基类，定义所有参赛者的公共接口和行为
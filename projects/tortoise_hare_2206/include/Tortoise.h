@@ -19,12 +19,15 @@
  */
 class Tortoise final : public Racer {
 public:
+    /// 移动规则表（按随机数1-10索引），供 move() 和无界面的模拟共用
+    static constexpr MoveTable MOVES = {3, 3, 3, 3, 3, -6, -6, 1, 1, 1};
+
     /// 构造函数，初始化名称为"Tortoise"，符号为'T'
     Tortoise();
 
     /**
      * @brief 实现乌龟的移动规则
-     * @details 根据随机数决定移动类型：快速、滑倒或缓慢
+     * @details 根据随机数查移动规则表：快速、滑倒或缓慢
      */
     void move() override;
 };
@@ -2,28 +2,223 @@
 #include "Hare.h"
 #include "Race.h"
 #include "RacerConcept.h"
+#include "RaceSimulator.h"
+#include "MassRace.h"
+#include "RaceSolver.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
-#include <memory>
+#include <numeric>
 #include <format>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
 
 // 编译期验证：确保Tortoise和Hare类型满足RacerConcept概念
 static_assert(RacerConcept<Tortoise>, "Tortoise类必须满足RacerConcept概念");
 static_assert(RacerConcept<Hare>, "Hare类必须满足RacerConcept概念");
 
+/// 直方图每行合并的滴答数
+constexpr int HISTOGRAM_BUCKET = 10;
+
+/// 直方图最长一行的字符数
+constexpr int HISTOGRAM_WIDTH = 50;
+
+/// 直方图末尾合并为一行的比赛所占的最大百分比
+constexpr double HISTOGRAM_TAIL = 0.1;
+
+/**
+ * @brief 把整个字符串解析为无符号整数
+ * @return 解析成功返回true
+ */
+template<typename T>
+bool parseNumber(std::string_view text, T& value) {
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+/**
+ * @brief 无界面模拟模式：模拟大量比赛，输出胜负分布和比赛用时直方图
+ * @param races 比赛场数
+ * @param threads 线程数，为0时使用全部硬件线程
+ * @param seed 随机数种子
+ */
+void runSimulation(std::uint64_t races, unsigned threads, std::uint64_t seed) {
+    const RaceSimulator simulator(Tortoise::MOVES, Hare::MOVES);
+
+    const auto start = std::chrono::steady_clock::now();
+    const SimulationResult result = simulator.run(races, seed, threads);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto percent = [&](std::uint64_t count) {
+        return result.races == 0 ? 0.0 : 100.0 * static_cast<double>(count) / static_cast<double>(result.races);
+    };
+
+    // 与精确解对照：偏差以标准误差为单位，通常在 ±3 以内
+    const ExactResult exact = RaceSolver(Tortoise::MOVES, Hare::MOVES).solve();
+    const auto deviation = [&](double simulated, double expected, double variance) {
+        const double error = std::sqrt(variance / static_cast<double>(std::max<std::uint64_t>(result.races, 1)));
+        return error == 0 ? 0.0 : (simulated - expected) / error;
+    };
+    const auto printOutcome = [&](std::string_view label, std::uint64_t count, double probability) {
+        std::cout << std::format("{:<14} {:>12} ({:6.3f}%)  exact {:6.3f}%  {:+6.2f} SE\n", label, count,
+                                 percent(count), 100.0 * probability,
+                                 deviation(percent(count) / 100.0, probability, probability * (1.0 - probability)));
+    };
+
+    std::cout << std::format("Simulated {} races in {:.3f} s ({:.1f} million races/s)\n\n",
+                             result.races, elapsed.count(), static_cast<double>(result.races) / elapsed.count() / 1e6);
+    printOutcome("Tortoise wins:", result.racer1Wins, exact.racer1Wins);
+    printOutcome("Hare wins:", result.racer2Wins, exact.racer2Wins);
+    printOutcome("Ties:", result.ties, exact.ties);
+    std::cout << std::format("Mean ticks:    {:>12.3f}            exact {:7.3f}  {:+6.2f} SE\n\n", result.meanTicks(),
+                             exact.meanTicks, deviation(result.meanTicks(), exact.meanTicks, exact.tickVariance));
+
+    // 每 HISTOGRAM_BUCKET 个滴答合并为一行；合计不到 HISTOGRAM_TAIL 的最长的那些比赛合并为最后一行
+    const auto& histogram = result.tickHistogram;
+    std::vector<std::uint64_t> buckets;
+    for (int t = 1; t < RaceSimulator::MAX_HISTOGRAM_TICKS; ++t) {
+        const auto bucket = static_cast<std::size_t>((t - 1) / HISTOGRAM_BUCKET);
+        buckets.resize(std::max(buckets.size(), bucket + 1), 0);
+        buckets[bucket] += histogram[static_cast<std::size_t>(t)];
+    }
+
+    std::uint64_t tail = histogram.back();
+    while (!buckets.empty() && percent(tail + buckets.back()) < HISTOGRAM_TAIL) {
+        tail += buckets.back();
+        buckets.pop_back();
+    }
+
+    // 精确解中第 first 个滴答及以后结束的概率（含未解出的部分）
+    const auto exactFrom = [&](std::size_t first) {
+        const auto& distribution = exact.tickDistribution;
+        const auto begin = distribution.begin() + static_cast<std::ptrdiff_t>(std::min(first, distribution.size()));
+        return std::accumulate(begin, distribution.end(), exact.unresolved);
+    };
+
+    const std::uint64_t largest = buckets.empty() ? 1 : std::max<std::uint64_t>(std::ranges::max(buckets), 1);
+    std::cout << "Ticks        Races     Exact\n";
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        const auto bar = static_cast<std::size_t>(buckets[i] * HISTOGRAM_WIDTH / largest);
+        const double expected = exactFrom(i * HISTOGRAM_BUCKET + 1) - exactFrom((i + 1) * HISTOGRAM_BUCKET + 1);
+        std::cout << std::format("{:>4}-{:<4} {:7.3f}%  {:7.3f}% {}\n", i * HISTOGRAM_BUCKET + 1, (i + 1) * HISTOGRAM_BUCKET,
+                                 percent(buckets[i]), 100.0 * expected, std::string(bar, '#'));
+    }
+    if (tail != 0) {
+        std::cout << std::format("{:>4}+     {:7.3f}%  {:7.3f}%\n", buckets.size() * HISTOGRAM_BUCKET + 1, percent(tail),
+                                 100.0 * exactFrom(buckets.size() * HISTOGRAM_BUCKET + 1));
+    }
+}
+
+/**
+ * @brief 精确求解模式：用马尔可夫链动态规划计算胜负概率和比赛滴答数的期望
+ */
+void runExact() {
+    const RaceSolver solver(Tortoise::MOVES, Hare::MOVES);
+
+    const auto start = std::chrono::steady_clock::now();
+    const ExactResult result = solver.solve();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << std::format("Solved exactly in {:.3f} ms ({} ticks, unresolved probability {:.1e})\n\n",
+                             elapsed.count(), result.tickDistribution.size() - 1, result.unresolved);
+    std::cout << std::format("Tortoise wins: {:12.9f}%\n", 100.0 * result.racer1Wins);
+    std::cout << std::format("Hare wins:     {:12.9f}%\n", 100.0 * result.racer2Wins);
+    std::cout << std::format("Ties:          {:12.9f}%\n", 100.0 * result.ties);
+    std::cout << std::format("Mean ticks:    {:12.9f}\n", result.meanTicks);
+    std::cout << std::format("Std. dev.:     {:12.9f}\n", std::sqrt(result.tickVariance));
+}
+
+/**
+ * @brief 多人比赛模式：乌龟和兔子交替报名，同场比赛一次，输出获胜情况
+ * @param racers 参赛者人数
+ * @param seed 随机数种子
+ */
+void runField(std::size_t racers, std::uint64_t seed) {
+    MassRace race(seed);
+    race.reserve(racers);
+    for (std::size_t i = 0; i < racers; ++i) {
+        race.addRacer(i % 2 == 0 ? Tortoise::MOVES : Hare::MOVES);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const MassRaceResult result = race.run();
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto tortoises = std::ranges::count_if(result.winners, [](std::size_t i) { return i % 2 == 0; });
+    const auto racerTicks = static_cast<double>(racers) * std::max(result.ticks, 1);
+
+    std::cout << std::format("Field race: {} racers ({} tortoises, {} hares)\n", racers, (racers + 1) / 2, racers / 2);
+    std::cout << std::format("Finished in {} ticks ({:.2f} ns per racer per tick)\n", result.ticks,
+                             elapsed.count() / racerTicks);
+    std::cout << std::format("Winners: {} ({} tortoises, {} hares)\n", result.winners.size(), tortoises,
+                             static_cast<std::ptrdiff_t>(result.winners.size()) - tortoises);
+}
+
 /**
  * @brief 程序入口点
+ * @details 不带参数时运行一场有赛道显示的比赛，--every K 每 K 个滴答显示一次赛道；
+ *          --simulate N [--threads T] [--seed S] 进入无界面模拟模式；
+ *          --field N [--seed S] 让 N 名参赛者同场比赛；
+ *          --exact 精确计算胜负概率
  * @return 0表示程序成功执行，1表示发生错误
  */
-int main() {
+int main(int argc, char* argv[]) {
     try {
-        // 创建参赛者对象（使用智能指针自动管理内存）
-        auto tortoise = std::make_unique<Tortoise>();
-        auto hare = std::make_unique<Hare>();
+        if (argc == 2 && std::string_view(argv[1]) == "--exact") {
+            runExact();
+            return 0;
+        }
+
+        int renderEvery = 1;
+        if (argc > 1) {
+            const std::string_view mode = argv[1];
+            std::uint64_t count = 0;
+            unsigned threads = 0;
+            std::uint64_t seed = std::random_device{}();
+            bool valid = argc % 2 == 1 && (mode == "--simulate" || mode == "--field" || mode == "--every")
+                      && parseNumber(argv[2], count);
+
+            for (int i = 3; valid && i + 1 < argc; i += 2) {
+                const std::string_view option = argv[i];
+                if (option == "--threads" && mode == "--simulate") {
+                    valid = parseNumber(argv[i + 1], threads) && threads <= RaceSimulator::MAX_THREADS;
+                } else if (option == "--seed" && mode != "--every") {
+                    valid = parseNumber(argv[i + 1], seed);
+                } else {
+                    valid = false;
+                }
+            }
+
+            if (!valid || (mode != "--simulate" && count == 0) || (mode == "--every" && count > INT_MAX)
+                || (mode == "--field" && count > MassRace::MAX_RACERS)) {
+                std::cerr << std::format("用法: {0} [--every 滴答数]\n"
+                                         "      {0} --simulate 场数 [--threads 线程数] [--seed 种子]\n"
+                                         "      {0} --field 人数 [--seed 种子]\n"
+                                         "      {0} --exact\n", argv[0]);
+                return 1;
+            }
+            if (mode == "--simulate") {
+                runSimulation(count, threads, seed);
+                return 0;
+            }
+            if (mode == "--field") {
+                runField(static_cast<std::size_t>(count), seed);
+                return 0;
+            }
+            renderEvery = static_cast<int>(count);
+        }
 
-        // 创建比赛对象并运行
+        // 创建比赛对象并运行，参赛者按值保存在比赛对象中
         // 使用CTAD (类模板参数推导)
-        Race race(std::move(tortoise), std::move(hare));
-        race.run();
+        Race race(Tortoise{}, Hare{});
+        race.run(renderEvery);
 
     } catch (const std::exception& e) {
         // 捕获并处理可能的异常
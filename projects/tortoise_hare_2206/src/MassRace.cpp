@@ -0,0 +1,116 @@
+/**
+ * @file MassRace.cpp
+ * @brief 大量参赛者同场比赛的实现
+ */
+
+#include "MassRace.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+MassRace::MassRace(std::uint64_t seed) noexcept : rng(seed) {}
+
+std::size_t MassRace::addRacer(const MoveTable& racerMoves) {
+    if (!std::ranges::all_of(racerMoves, [](int move) {
+            return move >= std::numeric_limits<std::int8_t>::min() && move <= std::numeric_limits<std::int8_t>::max();
+        })) {
+        throw std::invalid_argument("位移超出 -128 ~ 127 的范围");
+    }
+
+    if (count == positions.size()) {
+        // 再补齐一组，新的位置都在起点，位移都为零
+        positions.resize(count + BLOCK, START_LINE);
+        for (auto& row : moves) {
+            row.resize(count + BLOCK, 0);
+        }
+    }
+
+    for (std::size_t k = 0; k < ROLL_SIDES; ++k) {
+        moves[k][count] = static_cast<std::int8_t>(racerMoves[k]);
+    }
+    return count++;
+}
+
+void MassRace::reserve(std::size_t racers) {
+    const std::size_t padded = (racers + BLOCK - 1) / BLOCK * BLOCK;
+    positions.reserve(padded);
+    for (auto& row : moves) {
+        row.reserve(padded);
+    }
+}
+
+std::size_t MassRace::size() const noexcept {
+    return count;
+}
+
+std::span<const int> MassRace::getPositions() const noexcept {
+    return {positions.data(), count};
+}
+
+void MassRace::reset() noexcept {
+    std::ranges::fill(positions, START_LINE);
+}
+
+void MassRace::tick() noexcept {
+    std::array<std::uint64_t, LANES> bits{};
+    std::array<std::int8_t, CHUNK> rolls{};
+    std::array<std::int8_t, CHUNK> steps{};
+    std::array<const std::int8_t*, ROLL_SIDES> rows{};
+
+    for (std::size_t base = 0; base < positions.size(); base += CHUNK) {
+        const std::size_t length = std::min(CHUNK, positions.size() - base);
+
+        // 随机数的高低 32 位各乘以 ROLL_SIDES 取高位，得到 0 ~ ROLL_SIDES-1
+        // （偏差不超过 ROLL_SIDES / 2^32，可以忽略）
+        for (std::size_t j = 0; j < length; j += BLOCK) {
+            rng(bits);
+            for (std::size_t i = 0; i < LANES; ++i) {
+                rolls[j + i] = static_cast<std::int8_t>(((bits[i] & 0xffffffff) * ROLL_SIDES) >> 32);
+                rolls[j + i + LANES] = static_cast<std::int8_t>(((bits[i] >> 32) * ROLL_SIDES) >> 32);
+            }
+        }
+
+        // 逐个规则数组用掩码选出掷出该点数的人的位移，代替按点数查表；
+        // 写成与运算而不是条件表达式，编译器才会向量化
+        for (std::size_t k = 0; k < ROLL_SIDES; ++k) {
+            rows[k] = moves[k].data() + base;
+        }
+        for (std::size_t i = 0; i < length; ++i) {
+            std::int8_t step = 0;
+            for (std::size_t k = 0; k < ROLL_SIDES; ++k) {
+                const auto mask = static_cast<std::int8_t>(-static_cast<std::int8_t>(rolls[i] == static_cast<std::int8_t>(k)));
+                step = static_cast<std::int8_t>(step | (rows[k][i] & mask));
+            }
+            steps[i] = step;
+        }
+
+        int* position = positions.data() + base;
+        for (std::size_t i = 0; i < length; ++i) {
+            position[i] = std::max(position[i] + steps[i], START_LINE);  // 不会滑出起点
+        }
+    }
+}
+
+bool MassRace::hasFinished() const noexcept {
+    // 补齐的参赛者停在起点，不影响结果
+    return !positions.empty() && std::ranges::max(positions) >= FINISH_LINE;
+}
+
+MassRaceResult MassRace::run(int maxTicks) {
+    MassRaceResult result;
+    if (count == 0) {
+        return result;
+    }
+
+    while (result.ticks < maxTicks && !hasFinished()) {
+        tick();
+        ++result.ticks;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (positions[i] >= FINISH_LINE) {
+            result.winners.push_back(i);
+        }
+    }
+    return result;
+}
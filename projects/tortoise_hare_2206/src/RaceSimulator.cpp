@@ -0,0 +1,141 @@
+/**
+ * @file RaceSimulator.cpp
+ * @brief 无界面的蒙特卡洛比赛模拟器实现
+ */
+
+#include "RaceSimulator.h"
+#include "Xoshiro256.h"
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief 从 64 位随机数中依次取出 32 位，无偏地生成 [0, n) 的整数
+ * @details 使用 Lemire 的乘法取高位法，只有极少数情况需要重新取数
+ */
+class BoundedRoller {
+public:
+    explicit BoundedRoller(Xoshiro256& engine) noexcept : rng(engine) {}
+
+    [[nodiscard]] std::uint32_t operator()(std::uint32_t n) noexcept {
+        std::uint64_t m = std::uint64_t{next32()} * n;
+        auto low = static_cast<std::uint32_t>(m);
+        if (low < n) {
+            const std::uint32_t threshold = (0u - n) % n;
+            while (low < threshold) {
+                m = std::uint64_t{next32()} * n;
+                low = static_cast<std::uint32_t>(m);
+            }
+        }
+        return static_cast<std::uint32_t>(m >> 32);
+    }
+
+private:
+    Xoshiro256& rng;
+    std::uint64_t buffer{0};
+    bool hasHalf{false};
+
+    std::uint32_t next32() noexcept {
+        if (hasHalf) {
+            hasHalf = false;
+            return static_cast<std::uint32_t>(buffer >> 32);
+        }
+        buffer = rng();
+        hasHalf = true;
+        return static_cast<std::uint32_t>(buffer);
+    }
+};
+
+} // namespace
+
+double SimulationResult::meanTicks() const noexcept {
+    return races == 0 ? 0.0 : static_cast<double>(totalTicks) / static_cast<double>(races);
+}
+
+void SimulationResult::merge(const SimulationResult& other) {
+    races += other.races;
+    racer1Wins += other.racer1Wins;
+    racer2Wins += other.racer2Wins;
+    ties += other.ties;
+    totalTicks += other.totalTicks;
+
+    tickHistogram.resize(std::max(tickHistogram.size(), other.tickHistogram.size()), 0);
+    for (std::size_t t = 0; t < other.tickHistogram.size(); ++t) {
+        tickHistogram[t] += other.tickHistogram[t];
+    }
+}
+
+RaceSimulator::RaceSimulator(const MoveTable& racer1Moves, const MoveTable& racer2Moves) noexcept {
+    // 两个参赛者各掷一次等价于从 ROLL_SIDES^2 种组合中取一种
+    for (int r1 = 0; r1 < ROLL_SIDES; ++r1) {
+        for (int r2 = 0; r2 < ROLL_SIDES; ++r2) {
+            moves1[r1 * ROLL_SIDES + r2] = racer1Moves[r1];
+            moves2[r1 * ROLL_SIDES + r2] = racer2Moves[r2];
+        }
+    }
+}
+
+SimulationResult RaceSimulator::run(std::uint64_t races, std::uint64_t seed, unsigned threads) const {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // 每个线程至少分到一场比赛
+    threads = static_cast<unsigned>(std::min<std::uint64_t>(threads, std::max<std::uint64_t>(races, 1)));
+
+    // 第 i 个线程的序列向前跳 i 次
+    std::vector<Xoshiro256> streams;
+    Xoshiro256 rng(seed);
+    for (unsigned i = 0; i < threads; ++i) {
+        streams.push_back(rng);
+        rng.jump();
+    }
+
+    std::vector<SimulationResult> partial(threads);
+    {
+        std::vector<std::jthread> pool;
+        for (unsigned i = 1; i < threads; ++i) {
+            const std::uint64_t count = races * (i + 1) / threads - races * i / threads;
+            pool.emplace_back([&, i, count] { simulate(count, streams[i], partial[i]); });
+        }
+        simulate(races / threads, streams[0], partial[0]);
+    }
+
+    SimulationResult result;
+    for (const SimulationResult& part : partial) {
+        result.merge(part);
+    }
+    return result;
+}
+
+void RaceSimulator::simulate(std::uint64_t races, Xoshiro256& rng, SimulationResult& result) const {
+    BoundedRoller roll(rng);
+    std::vector<std::uint64_t> histogram(MAX_HISTOGRAM_TICKS + 1, 0);
+    std::uint64_t wins1 = 0;
+    std::uint64_t wins2 = 0;
+    std::uint64_t ties = 0;
+    std::uint64_t totalTicks = 0;
+
+    for (std::uint64_t race = 0; race < races; ++race) {
+        int pos1 = START_LINE;
+        int pos2 = START_LINE;
+        int ticks = 0;
+
+        do {
+            ++ticks;
+            const std::uint32_t pair = roll(ROLL_SIDES * ROLL_SIDES);
+            pos1 = std::max(pos1 + moves1[pair], START_LINE);
+            pos2 = std::max(pos2 + moves2[pair], START_LINE);
+        } while (pos1 < FINISH_LINE && pos2 < FINISH_LINE);
+
+        const bool finished1 = pos1 >= FINISH_LINE;
+        const bool finished2 = pos2 >= FINISH_LINE;
+        ties += finished1 && finished2;
+        wins1 += finished1 && !finished2;
+        wins2 += finished2 && !finished1;
+        totalTicks += static_cast<std::uint64_t>(ticks);
+        ++histogram[std::min(ticks, MAX_HISTOGRAM_TICKS)];
+    }
+
+    result.merge(SimulationResult{races, wins1, wins2, ties, totalTicks, std::move(histogram)});
+}
@@ -0,0 +1,98 @@
+/**
+ * @file RaceSolver.cpp
+ * @brief 按马尔可夫链精确计算比赛结果概率的求解器实现
+ */
+
+#include "RaceSolver.h"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+/**
+ * @class PositionChain
+ * @brief 一名参赛者位置的概率分布，逐个滴答推进
+ */
+class PositionChain {
+public:
+    explicit PositionChain(const MoveTable& moves) noexcept : moves(moves) {
+        distribution[START_LINE] = 1.0;
+    }
+
+    /**
+     * @brief 推进一个滴答
+     * @return 在这个滴答到达终点的概率
+     */
+    double step() noexcept {
+        std::array<double, FINISH_LINE> next{};
+        double finished = 0;
+
+        for (int p = START_LINE; p < FINISH_LINE; ++p) {
+            const double share = distribution[static_cast<std::size_t>(p)] / ROLL_SIDES;
+            if (share == 0) {
+                continue;
+            }
+            for (const int move : moves) {
+                const int target = std::max(p + move, START_LINE);  // 不会滑出起点
+                if (target >= FINISH_LINE) {
+                    finished += share;
+                } else {
+                    next[static_cast<std::size_t>(target)] += share;
+                }
+            }
+        }
+
+        distribution = next;
+        survival = std::accumulate(next.begin(), next.end(), 0.0);  // 逐项求和，避免 1 - Σ 的抵消误差
+        return finished;
+    }
+
+    /// 到目前为止仍未到达终点的概率
+    [[nodiscard]] double getSurvival() const noexcept {
+        return survival;
+    }
+
+private:
+    MoveTable moves;
+    std::array<double, FINISH_LINE> distribution{};  ///< 第 p 项为位于第 p 格的概率
+    double survival{1.0};
+};
+
+} // namespace
+
+RaceSolver::RaceSolver(const MoveTable& racer1Moves, const MoveTable& racer2Moves) noexcept
+    : moves1(racer1Moves), moves2(racer2Moves) {}
+
+ExactResult RaceSolver::solve(double tolerance) const {
+    ExactResult result;
+    result.tickDistribution.push_back(0.0);  // 第 0 个滴答不会结束
+
+    PositionChain chain1(moves1);
+    PositionChain chain2(moves2);
+    double unresolved = 1.0;  // 比赛到上一个滴答为止仍未结束的概率
+    double secondMoment = 0;
+
+    for (int tick = 1; tick <= MAX_TICKS && unresolved > tolerance; ++tick) {
+        const double before1 = chain1.getSurvival();
+        const double before2 = chain2.getSurvival();
+        const double finished1 = chain1.step();
+        const double finished2 = chain2.step();
+        const double after1 = chain1.getSurvival();
+        const double after2 = chain2.getSurvival();
+
+        // 两人的位置相互独立：一人这个滴答到达、另一人仍未到达即为获胜
+        result.racer1Wins += finished1 * after2;
+        result.racer2Wins += finished2 * after1;
+        result.ties += finished1 * finished2;
+
+        const double ended = before1 * before2 - after1 * after2;
+        result.tickDistribution.push_back(ended);
+        result.meanTicks += ended * tick;
+        secondMoment += ended * tick * tick;
+        unresolved = after1 * after2;
+    }
+
+    result.tickVariance = secondMoment - result.meanTicks * result.meanTicks;
+    result.unresolved = unresolved;
+    return result;
+}
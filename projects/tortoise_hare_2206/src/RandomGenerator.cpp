@@ -4,10 +4,11 @@
  */
 
 #include "RandomGenerator.h"
+#include "Constants.h"
 
 RandomGenerator::RandomGenerator()
     : engine(std::random_device{}()),
-      distribution(1, 10) {}
+      distribution(1, ROLL_SIDES) {}
 
 int RandomGenerator::generate() {
     return distribution(engine);